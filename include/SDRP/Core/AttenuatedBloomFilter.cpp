@@ -0,0 +1,165 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/AttenuatedBloomFilter.h>
+#include <SDRP/Core/Macros.h>
+#include <SDRP/Utilities/Serializer.h>
+
+namespace Radicle { namespace SDRP
+{
+	const RDSize	AttenuatedBloomFilter::DefaultDepth	= 4;
+	const RDSize	AttenuatedBloomFilter::MaximumDepth	= 16;
+
+	AttenuatedBloomFilter::AttenuatedBloomFilter( const RDSize depth ) :
+	m_levels( depth > 0 ? depth : 1, BloomFilter( ( RDSize ) 0, ( RDSize ) 0 ) )
+	{}
+
+	AttenuatedBloomFilter& AttenuatedBloomFilter::Merge( const BloomFilter& filter, const RDSize hops )
+	{
+		if( filter.HasElements() == false )
+		{
+			return ( *this );
+		}
+
+		// Anything further than the last level is held by it
+		BloomFilter& level = m_levels[ hops < m_levels.size() ? hops : m_levels.size() - 1 ];
+
+		if( level.TableSize() == 0 )
+		{
+			level = filter;
+		}
+		else if( level.HashCount() == filter.HashCount() && level.Foldable( filter ) )
+		{
+			level.UnionWith( filter );
+		}
+		else
+		{
+			level.Universe();
+		}
+
+		return ( *this );
+	}
+
+	AttenuatedBloomFilter& AttenuatedBloomFilter::Merge( const AttenuatedBloomFilter& other, const RDSize hops )
+	{
+		for( RDSize i = 0; i < other.m_levels.size(); i++ )
+		{
+			Merge( other.m_levels[ i ], i + hops );
+		}
+
+		return ( *this );
+	}
+
+	bool AttenuatedBloomFilter::Nearest( const RDIdentifier id, RDSize& hops ) const
+	{
+		for( RDSize i = 0; i < m_levels.size(); i++ )
+		{
+			if( m_levels[ i ].HasElements() && m_levels[ i ].Contains( id ) )
+			{
+				hops = i;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool AttenuatedBloomFilter::Contains( const RDIdentifier id ) const
+	{
+		RDSize hops;
+		return Nearest( id, hops );
+	}
+
+	bool AttenuatedBloomFilter::HasElements() const
+	{
+		for( RDSize i = 0; i < m_levels.size(); i++ )
+		{
+			if( m_levels[ i ].HasElements() )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void AttenuatedBloomFilter::Clear()
+	{
+		m_levels.assign( m_levels.size(), BloomFilter( ( RDSize ) 0, ( RDSize ) 0 ) );
+	}
+
+	const RDSize AttenuatedBloomFilter::Depth() const
+	{
+		return m_levels.size();
+	}
+
+	const BloomFilter& AttenuatedBloomFilter::Level( const RDSize hops ) const
+	{
+		return m_levels[ hops ];
+	}
+
+	bool AttenuatedBloomFilter::Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const
+	{
+		if( Serializer::SerializeVarint( buffer, bufferSize, offset, newOffset, m_levels.size() ) )
+		{
+			for( RDSize i = 0; i < m_levels.size(); i++ )
+			{
+				if( m_levels[ i ].Serialize( buffer, bufferSize, newOffset, newOffset ) == false )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool AttenuatedBloomFilter::Deserialize( 	const RDUByte8* buffer,
+							const RDSize bufferSize,
+							const RDSize offset,
+							RDSize& newOffset )
+	{
+		RDSize depth;
+
+		if( Serializer::DeserializeVarint( buffer, bufferSize, offset, newOffset, depth ) )
+		{
+			if( depth == 0 || depth > MaximumDepth )
+			{
+				RD_PRINT( "Attenuated Filter Depth " << depth << " is out of range" );
+				return false;
+			}
+
+			m_levels.assign( depth, BloomFilter( ( RDSize ) 0, ( RDSize ) 0 ) );
+
+			for( RDSize i = 0; i < depth; i++ )
+			{
+				if( m_levels[ i ].Deserialize( buffer, bufferSize, newOffset, newOffset ) == false )
+				{
+					RD_PRINT( "Failed to Deserialize Attenuated Filter Level " << i );
+					Clear();
+					return false;
+				}
+			}
+
+			return true;
+		}
+		else
+		{
+			RD_PRINT( "Failed to Deserialize Attenuated Filter Header" );
+		}
+
+		return false;
+	}
+} }
@@ -0,0 +1,133 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_ATTENUATED_BLOOM_FILTER_H
+#define RD_SDRP_ATTENUATED_BLOOM_FILTER_H
+
+#include <vector>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/BloomFilter.h>
+#include <SDRP/Core/ISerializable.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	An attenuated bloom filter. Holds one filter per hop distance, such that level i holds the
+	 *	identifiers reachable in i hops and the last level those reachable in as many hops or more.
+	 *	Filters merged into a level are folded to the smallest size among them, so a level answers
+	 *	for every filter merged into it with a single probe.
+	 */
+	class AttenuatedBloomFilter : public ISerializable
+	{
+	public:
+
+		/// Number of Levels in a Default Constructed Filter
+		const static RDSize	DefaultDepth;
+		/// Most levels accepted when deserializing a filter
+		const static RDSize	MaximumDepth;
+
+		/**
+		 *	Default Constructor
+		 * @param depth		Number of Levels
+		 */
+		AttenuatedBloomFilter( const RDSize depth = DefaultDepth );
+
+		/**
+		 *	Merge a filter into the level for the given hop distance. Where a filter cannot be folded
+		 *	to the size of the level, or uses a different hash count, the level is filled, trading
+		 *	precision at that distance for the guarantee of no false negatives.
+		 * @param filter	Filter to be merged
+		 * @param hops		Hop Distance of the filter's elements
+		 */
+		AttenuatedBloomFilter& Merge( const BloomFilter& filter, const RDSize hops );
+
+		/**
+		 *	Merge every level of another attenuated filter, each moved the given number of hops
+		 *	further away. A relay merges its neighbours' filters one hop further to advertise
+		 *	them as its own.
+		 * @param other		Filter to be merged
+		 * @param hops		Hops added to the distance of each level
+		 */
+		AttenuatedBloomFilter& Merge( const AttenuatedBloomFilter& other, const RDSize hops );
+
+		/**
+		 *	Find the nearest level containing the given identifier
+		 * @param id		Identifier to be checked
+		 * @param hops[out]	Hop Distance of the nearest level containing the identifier
+		 * @return		True - If any level contains the identifier. False otherwise.
+		 */
+		bool Nearest( const RDIdentifier id, RDSize& hops ) const;
+
+		/**
+		 *	Check whether any level contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If any level contains the identifier. False otherwise.
+		 */
+		bool Contains( const RDIdentifier id ) const;
+
+		/**
+		 *	Check whether any level contains any elements
+		 * @return	True - If any level contains any elements. False otherwise.
+		 */
+		bool HasElements() const;
+
+		/**
+		 *	Clear every level
+		 */
+		void Clear();
+
+		/**
+		 *	Get the number of levels in the filter
+		 * @return	Level Count
+		 */
+		const RDSize Depth() const;
+
+		/**
+		 *	Get the specified level. Levels nothing has been merged into have a table size of zero.
+		 * @param hops	Hop Distance
+		 * @return	Level Filter
+		 */
+		const BloomFilter& Level( const RDSize hops ) const;
+
+		/**
+		 *	Serialize this filter into the provided data buffer. The depth is written as a varint,
+		 *	followed by each level, the nearest first.
+		 * @param buffer	Data buffer into which the object should be serialized
+		 * @param bufferSize	Size of the data buffer in bytes
+		 * @param offset	Offset into the buffer at which serialization should begin
+		 * @param newOffset	New offset produced by serialization
+		 * @return		True - If serialization was successful. False otherwise.
+		 */
+		virtual bool Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const;
+
+		/**
+		 *	Deserialize this filter from the provided data buffer
+		 * @param buffer	Data buffer from which the object should be deserialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which deserialization should begin
+		 * @param newOffset	New offset produced by deserializing the object
+		 * @return		True - If deserialization was successful. False otherwise.
+		 */
+		virtual bool Deserialize( 	const RDUByte8* buffer,
+		 				const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset );
+
+	private:
+
+		/// Levels, the nearest first
+		std::vector<BloomFilter>	m_levels;
+	};
+} }
+
+#endif // RD_SDRP_ATTENUATED_BLOOM_FILTER_H
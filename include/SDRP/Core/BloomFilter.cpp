@@ -13,42 +13,167 @@
 #include <SDRP/Core/ErrorCodes.h>
 #include <SDRP/Utilities/Serializer.h>
 #include <SDRP/Utilities/MurmurHash.h>
+#include <SDRP/Utilities/FilterKernels.h>
+#include <SDRP/Core/PoolAllocator.h>
 #include <limits>
 #include <complex>
 #include <cstring>
+#include <vector>
+#ifdef RD_SDRP_MOVE_SEMANTICS
+#include <utility>
+#endif
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <xmmintrin.h>
+#endif
 
 namespace Radicle { namespace SDRP
 {
 	const RDSize		BloomFilter::BitsPerChar		= 8;
+	const RDSize		BloomFilter::BlockSlots			= 512;
+	const RDSize		BloomFilter::InlineBytes		= RD_SDRP_BLOOM_FILTER_INLINE_BYTES;
 	RDSize 			BloomFilter::PredictedElementCount 	= 30;
 	RDDouble		BloomFilter::DesiredFalsePositiveRate 	= 0.1;
+	BloomFilter::TableLayout BloomFilter::MembershipLayout		= BloomFilter::Counting;
+	bool			BloomFilter::ShareTables		= true;
+	bool			BloomFilter::CompressTables		= false;
+	bool			BloomFilter::CompactHeaders		= false;
+	IAllocator*		BloomFilter::DefaultAllocator		= PoolAllocator::Instance();
+	bool			BloomFilter::PowerOfTwoSizes		= true;
+	BloomFilter::HashScheme	BloomFilter::DefaultHashScheme		= BloomFilter::ChainedHashing;
+	BloomFilter::IndexReduction BloomFilter::DefaultReduction	= BloomFilter::ModuloReduction;
+	const RDSize		BloomFilter::BlockedFormatFlag		= 0x01;
+	const RDSize		BloomFilter::DoubleHashingFormatFlag	= 0x02;
+	const RDSize		BloomFilter::MaskFormatFlag		= 0x04;
+	const RDSize		BloomFilter::MultiplyShiftFormatFlag	= 0x08;
+	const RDSize		BloomFilter::RunLengthFormatFlag	= 0x10;
+	const RDSize		BloomFilter::GolombFormatFlag		= 0x20;
+	const RDSize		BloomFilter::FormatFlagShift		= 56;
+	const RDUByte8		BloomFilter::CompactHeaderMarker	= 0x80;
+	const RDUByte8		BloomFilter::CompactHeaderVersion	= 0x00;
+	const RDUByte8		BloomFilter::HashCountEscape		= 0x0F;
+	const RDUByte8		BloomFilter::CounterMaximum		= 0x0F;
 	const BloomFilter	BloomFilter::Empty( ( RDSize ) 0, ( RDSize ) 0 );
 
-	std::map< std::pair<RDSize, RDDouble>, std::pair<RDSize, RDSize> > BloomFilter::m_cachedParameters;
+	namespace
+	{
+		/// Number of element counts, starting from zero, covered by the parameter table
+		const RDSize		TabulatedElements				= 256;
+		/// Number of false positive rates covered by the parameter table
+		const RDSize		TabulatedRates					= 4;
+		/// False positive rates covered by the parameter table
+		const RDDouble		TabulatedRate[ TabulatedRates ]			= { 0.1, 0.05, 0.01, 0.001 };
+		/// Tabulated Table Sizes, indexed by rate and element count
+		RDUInt32		TabulatedTableSize[ TabulatedRates ][ TabulatedElements ];
+		/// Tabulated Hash Counts, indexed by rate and element count
+		RDUInt32		TabulatedHashCount[ TabulatedRates ][ TabulatedElements ];
+
+		/// Number of identifiers probed together by batched insertions and queries
+		const RDSize		BatchSize					= 16;
+		/// Largest hash count handled by batched insertions and queries
+		const RDSize		BatchHashes					= 16;
+		/// Number of bytes of slot bits gathered from a counting table per digest round
+		const RDSize		DigestChunkBytes				= 64;
+
+		/**
+		 *	Get the allocator for a new filter. Filters constructed during static initialization may
+		 *	precede the default allocator being set.
+		 */
+		inline IAllocator* SelectAllocator()
+		{
+			return BloomFilter::DefaultAllocator != NULL ? BloomFilter::DefaultAllocator : PoolAllocator::Instance();
+		}
+
+		/**
+		 *	A block from an allocator, released when it goes out of scope. No block is allocated
+		 *	for a size of zero.
+		 */
+		class ScopedBlock
+		{
+		public:
+
+			ScopedBlock( IAllocator& allocator, const RDSize bytes ) :
+			m_allocator( allocator ),
+			m_bytes( bytes ),
+			m_block( bytes > 0 ? static_cast<RDUByte8*>( allocator.Allocate( bytes ) ) : NULL )
+			{}
+
+			~ScopedBlock()
+			{
+				if( m_block != NULL )
+				{
+					m_allocator.Release( m_block, m_bytes );
+				}
+			}
+
+			RDUByte8* Data()
+			{
+				return m_block;
+			}
+
+		private:
+
+			IAllocator&	m_allocator;
+			RDSize		m_bytes;
+			RDUByte8*	m_block;
+		};
+
+		/**
+		 *	Hint that the cache line holding the given address will soon be accessed
+		 */
+		inline void Prefetch( const void* address )
+		{
+#if defined( __GNUC__ )
+			__builtin_prefetch( address );
+#elif defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+			_mm_prefetch( static_cast<const char*>( address ), _MM_HINT_T0 );
+#endif
+		}
+	}
+
+	bool			BloomFilter::Tabulated			= BloomFilter::Tabulate();
 
 	BloomFilter::BloomFilter( 	const RDSize numElements, 
-					const RDDouble falsePositiveRate ) :
+					const RDDouble falsePositiveRate,
+					const TableLayout layout ) :
+	m_table( NULL ),
+	m_references( NULL ),
+	m_capacity( 0 ),
+	m_allocator( SelectAllocator() ),
 	m_tableSize( 0 ),
 	m_hashCount( 0 ),
-	m_table( NULL )
+	m_population( 0 ),
+	m_layout( layout ),
+	m_hashing( DefaultHashScheme ),
+	m_reduction( DefaultReduction )
 	{		
 		RDSize tableSize, hashCount;
 		CalculateParameters( numElements, falsePositiveRate >= 1.0 ? 0.1 : falsePositiveRate , tableSize, hashCount );
 		Initialize( tableSize, hashCount );
 	}
 	
-	BloomFilter::BloomFilter( const RDSize tableSize, const RDSize hashCount ) :
-	m_table( NULL ), m_tableSize( 0 ), m_hashCount( 0 )
+	BloomFilter::BloomFilter( const RDSize tableSize, const RDSize hashCount, const TableLayout layout ) :
+	m_table( NULL ), m_references( NULL ), m_capacity( 0 ), m_allocator( SelectAllocator() ), m_tableSize( 0 ), m_hashCount( 0 ), m_population( 0 ), m_layout( layout ), m_hashing( DefaultHashScheme ),
+	m_reduction( DefaultReduction )
 	{
 		Initialize( tableSize, hashCount );
 	}
 	
 	BloomFilter::BloomFilter( const BloomFilter& other ) :
-	m_table( NULL ), m_tableSize( 0 ), m_hashCount( 0 )
+	m_table( NULL ), m_references( NULL ), m_capacity( 0 ), m_allocator( SelectAllocator() ), m_tableSize( 0 ), m_hashCount( 0 ), m_population( 0 ), m_layout( other.m_layout ), 
+	m_hashing( other.m_hashing ), m_reduction( other.m_reduction )
 	{
 		( *this ) = other;
 	}
 
+#ifdef RD_SDRP_MOVE_SEMANTICS
+	BloomFilter::BloomFilter( BloomFilter&& other ) :
+	m_table( NULL ), m_references( NULL ), m_capacity( 0 ), m_allocator( SelectAllocator() ), m_tableSize( 0 ), m_hashCount( 0 ), m_population( 0 ), m_layout( other.m_layout ), 
+	m_hashing( other.m_hashing ), m_reduction( other.m_reduction )
+	{
+		( *this ) = std::move( other );
+	}
+#endif
+
 	void BloomFilter::ResetWithParameters( 	const RDSize numElements, 
 						const RDDouble falsePositiveRate )
 	{
@@ -60,12 +185,11 @@ namespace Radicle { namespace SDRP
 	{
 		if( m_tableSize > 0 )
 		{
-			RDUInt32 seed = 0;
+			Probe probe( *this, id );
 		
 			for( RDUInt32 i = 0; i < m_hashCount; i++ )
 			{
-				seed = MurmurHash::Hash( id, seed );
-				Set( seed );
+				Set( probe.Next() );
 			}
 		}
 
@@ -76,12 +200,11 @@ namespace Radicle { namespace SDRP
 	{
 		if( m_tableSize > 0 )
 		{
-			RDUInt32 seed = 0;
+			Probe probe( *this, id );
 		
 			for( RDUInt32 i = 0; i < m_hashCount; i++ )
 			{
-				seed = MurmurHash::Hash( id, seed );
-				if( Check( seed ) == false )
+				if( Check( probe.Next() ) == false )
 				{
 					return false;
 				}
@@ -93,85 +216,122 @@ namespace Radicle { namespace SDRP
 		return false;
 	}
 	
-	bool BloomFilter::Contains( const BloomFilter& filter ) const
+	BloomFilter& BloomFilter::InsertMany( const RDIdentifier* ids, const RDSize count )
 	{
-		if( m_tableSize > 0 )
+		if( m_tableSize == 0 )
 		{
-			for( RDSize i = 0; i < m_tableSize; ++i )
+			return ( *this );
+		}
+
+		if( m_hashCount > BatchHashes )
+		{
+			for( RDSize i = 0; i < count; i++ )
 			{
-				if( filter.Check( i ) )
-				{
-					if( Check( i ) == false )
-					{
-						return false;
-					}
-				}
+				Insert( ids[ i ] );
 			}
-		
-			return true;
+
+			return ( *this );
 		}
-		
-		return false;
-	}
-	
-	BloomFilter& BloomFilter::Remove( const RDIdentifier id )
-	{
-		if( m_tableSize > 0 && Contains( id ) )
+
+		RDSize slots[ BatchSize * BatchHashes ];
+
+		for( RDSize first = 0; first < count; first += BatchSize )
 		{
-			RDUInt32 seed = 0;
-		
-			for( RDUInt32 i = 0; i < m_hashCount; i++ )
+			RDSize batch = count - first < BatchSize ? count - first : BatchSize;
+			BatchProbes( ids + first, batch, slots );
+
+			for( RDSize i = 0; i < batch * m_hashCount; i++ )
 			{
-				seed = MurmurHash::Hash( id, seed ) % m_tableSize;
-			
-				if( m_table[ seed ] > 0 )
-				{
-					m_table[ seed ]--;
-				}
+				Set( slots[ i ] );
 			}
 		}
 
 		return ( *this );
 	}
-	
-	BloomFilter& BloomFilter::Remove( const BloomFilter& other ) throw( BloomFilterSizeMismatchException )
+
+	void BloomFilter::ContainsMany( const RDIdentifier* ids, const RDSize count, bool* results ) const
 	{
-		if( m_tableSize != other.m_tableSize )
+		if( m_tableSize == 0 || m_hashCount > BatchHashes )
 		{
-			throw BloomFilterSizeMismatchException();
+			for( RDSize i = 0; i < count; i++ )
+			{
+				results[ i ] = Contains( ids[ i ] );
+			}
+
+			return;
 		}
 
-		if( m_tableSize > 0 )
+		RDSize slots[ BatchSize * BatchHashes ];
+
+		for( RDSize first = 0; first < count; first += BatchSize )
 		{
-			if( this != &other )
+			RDSize batch = count - first < BatchSize ? count - first : BatchSize;
+			BatchProbes( ids + first, batch, slots );
+
+			for( RDSize i = 0; i < batch; i++ )
 			{
-				for( RDSize i = 0; i < m_tableSize; ++i )
+				bool contained = true;
+
+				for( RDSize j = 0; j < m_hashCount && contained; j++ )
 				{
-					if( m_table[i] > other.m_table[i] )
-					{
-						m_table[i] -= other.m_table[i];
-					}
-					else
-					{
-						m_table[i] = 0;
-					}
+					contained = Check( slots[ i * m_hashCount + j ] );
 				}
+
+				results[ first + i ] = contained;
 			}
-			else
+		}
+	}
+	
+	bool BloomFilter::Contains( const BloomFilter& filter ) const
+	{
+		if( m_tableSize == 0 || Foldable( filter ) == false )
+		{
+			return false;
+		}
+
+		if( m_tableSize != filter.m_tableSize )
+		{
+			BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0 );
+			return FoldLarger( filter, folded ) ? folded.Contains( filter ) : Contains( folded );
+		}
+
+		return m_layout == Blocked ? 	FilterKernels::BitCovers( m_table, filter.m_table, TableBytes() ) :
+						FilterKernels::CounterCovers( m_table, filter.m_table, TableBytes() );
+	}
+	
+	BloomFilter& BloomFilter::Remove( const RDIdentifier id )
+	{
+		if( m_layout == Counting && m_tableSize > 0 && Contains( id ) )
+		{
+			Unshare();
+			Probe probe( *this, id );
+		
+			for( RDUInt32 i = 0; i < m_hashCount; i++ )
 			{
-				Clear();
+				Decrement( probe.Next() );
 			}
 		}
 
 		return ( *this );
 	}
 	
+	BloomFilter& BloomFilter::Remove( const BloomFilter& other ) throw( BloomFilterSizeMismatchException )
+	{
+		return SubtractWith( other );
+	}
+	
 	BloomFilter& BloomFilter::Universe()
 	{
-		for( RDSize i = 0; i < m_tableSize; i++ )
+		Unshare();
+		std::fill_n( m_table, TableBytes(), static_cast<RDUByte8>( m_layout == Blocked ? 0xFF : 0x11 ) );
+
+		if( m_layout == Counting && m_tableSize % 2 != 0 )
 		{
-			m_table[i] = 1;
+			// The unused upper counter of an odd sized table must stay empty
+			m_table[ TableBytes() - 1 ] = 0x01;
 		}
+
+		m_population = m_tableSize;
 		return ( *this );
 	}
 	
@@ -181,38 +341,86 @@ namespace Radicle { namespace SDRP
 		return ( *this );
 	}
 
-	bool BloomFilter::RemovalResultsInDifference( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
+	BloomFilter& BloomFilter::Fold( const RDSize tableSize ) throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
+		if( FoldsTo( tableSize ) == false )
 		{
 			throw BloomFilterSizeMismatchException();
 		}
 
-		for( RDSize i = 0; i < m_tableSize; ++i )
+		if( tableSize == m_tableSize )
+		{
+			return ( *this );
+		}
+
+		BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0, m_layout );
+		folded.m_hashing = m_hashing;
+		folded.m_reduction = m_reduction;
+		folded.Initialize( tableSize, m_hashCount );
+
+		for( RDSize slot = 0; slot < m_tableSize; slot++ )
 		{
-			if( m_table[i] > 0 && m_table[i] <= other.m_table[i] )
+			RDUByte8 value = SlotValue( slot );
+
+			if( value == 0 )
 			{
-				return true;
+				continue;
+			}
+
+			RDSize target = FoldSlot( slot, tableSize );
+
+			if( m_layout == Blocked )
+			{
+				folded.SetBit( folded.m_table, target );
+				continue;
 			}
+
+			// Counters sum, saturating, so removals from the folded filter never empty a shared slot early
+			RDUByte8 sum = folded.SlotValue( target ) + value;
+			RDUByte8 shift = static_cast<RDUByte8>( ( target & 1 ) << 2 );
+
+			sum = sum > CounterMaximum ? CounterMaximum : sum;
+			folded.m_table[ target >> 1 ] = static_cast<RDUByte8>( ( folded.m_table[ target >> 1 ] & ~( CounterMaximum << shift ) ) | ( sum << shift ) );
 		}
 
-	
-		return false;
+		folded.Recount();
+		( *this ) = folded;
+
+		return ( *this );
 	}
 
-	bool BloomFilter::HasElements() const
+	bool BloomFilter::Foldable( const BloomFilter& other ) const
 	{
-		for( RDSize i = 0; i < m_tableSize; i++ )
+		if( m_layout != other.m_layout || m_hashing != other.m_hashing || m_reduction != other.m_reduction )
 		{
-			if( m_table[i] != 0 )
-			{
-				return true;
-			}
+			return false;
 		}
-		
-		return false;
+
+		return m_tableSize >= other.m_tableSize ? FoldsTo( other.m_tableSize ) : other.FoldsTo( m_tableSize );
+	}
+
+	bool BloomFilter::RemovalResultsInDifference( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
+	{
+		if( Compatible( other ) == false )
+		{
+			BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0 );
+			return FoldLarger( other, folded ) ? folded.RemovalResultsInDifference( other ) : RemovalResultsInDifference( folded );
+		}
+
+		return m_layout == Blocked ?	FilterKernels::BitRemovalEmpties( m_table, other.m_table, TableBytes() ) :
+						FilterKernels::CounterRemovalEmpties( m_table, other.m_table, TableBytes() );
+	}
+
+	bool BloomFilter::HasElements() const
+	{
+		return m_population > 0;
 	}
 	
+	RDDouble BloomFilter::EstimateCardinality() const
+	{
+		return Cardinality( m_population, m_tableSize, m_hashCount );
+	}
+
 	const RDSize BloomFilter::TableSize() const
 	{
 		return m_tableSize;
@@ -222,25 +430,62 @@ namespace Radicle { namespace SDRP
 	{
 		return m_hashCount;
 	}
-	
-	const RDSize BloomFilter::SetBytes() const
+
+	IAllocator& BloomFilter::Allocator() const
 	{
-		RDSize set = 0;
-		
-		for( RDSize i = 0; i < m_tableSize; i++ )
+		return *m_allocator;
+	}
+
+	BloomFilter& BloomFilter::Allocator( IAllocator& allocator )
+	{
+		if( &allocator == m_allocator )
 		{
-			if( Check( i ) )
-			{
-				set++;
-			}
+			return ( *this );
 		}
-		
-		return set;
+
+		if( m_references != NULL )
+		{
+			// Copy the table out before dropping this filter's reference to it
+			BloomFilter copy( *this );
+
+			Release();
+			m_allocator = &allocator;
+			Allocate( copy.m_capacity );
+			memcpy( m_table, copy.m_table, m_capacity );
+		}
+		else
+		{
+			m_allocator = &allocator;
+		}
+
+		return ( *this );
+	}
+
+	const BloomFilter::TableLayout BloomFilter::Layout() const
+	{
+		return m_layout;
+	}
+
+	const BloomFilter::HashScheme BloomFilter::Hashing() const
+	{
+		return m_hashing;
+	}
+
+	const BloomFilter::IndexReduction BloomFilter::Reduction() const
+	{
+		return m_reduction;
+	}
+	
+	const RDSize BloomFilter::SetBytes() const
+	{
+		return m_population;
 	}
 		
 	BloomFilter& BloomFilter::Clear()
 	{
-		std::fill_n( m_table, m_tableSize, static_cast<RDUByte8>( 0x00 ) );
+		Unshare();
+		std::fill_n( m_table, TableBytes(), static_cast<RDUByte8>( 0x00 ) );
+		m_population = 0;
 		return ( *this );
 	}
 
@@ -249,15 +494,57 @@ namespace Radicle { namespace SDRP
 					const RDSize offset,
 					RDSize& newOffset ) const
 	{
-		if( 	Serializer::Serialize( buffer, bufferSize, offset, newOffset, m_tableSize ) &&
-			Serializer::Serialize( buffer, bufferSize, newOffset, newOffset, m_hashCount ) )
+		RDSize packedBytes = PackedBytes( m_tableSize );
+		FilterCodec::Encoding encoding = FilterCodec::Raw;
+		const RDUByte8* bits = NULL;
+		ScopedBlock packed( *m_allocator, CompressTables && m_layout != Blocked ? packedBytes : 0 );
+
+		if( CompressTables && m_tableSize > 0 )
+		{
+			if( m_layout == Blocked )
+			{
+				bits = m_table;
+			}
+			else
+			{
+				std::fill_n( packed.Data(), packedBytes, static_cast<RDUByte8>( 0x00 ) );
+
+				for( RDSize bit = 0; bit < m_tableSize; ++bit )
+				{
+					if( Check( bit ) )
+					{
+						SetBit( packed.Data(), bit );
+					}
+				}
+
+				bits = packed.Data();
+			}
+
+			encoding = FilterCodec::Select( bits, packedBytes );
+		}
+
+		if( SerializeHeader( buffer, bufferSize, offset, newOffset, m_tableSize, EncodeFormat( m_hashCount, m_layout, m_hashing, m_reduction, encoding ) ) )
 		{
-			if( m_tableSize > 0 )
+			if( encoding != FilterCodec::Raw )
+			{
+				return FilterCodec::Encode( buffer, bufferSize, newOffset, newOffset, bits, packedBytes, encoding );
+			}
+			else if( m_layout == Blocked && m_tableSize > 0 )
+			{
+				return Serializer::BufferPack( buffer, bufferSize, newOffset, newOffset, m_table, TableBytes() );
+			}
+			else if( m_tableSize > 0 )
 			{
 				RDSize bitBufferSize = m_tableSize < BitsPerChar ? BitsPerChar : m_tableSize / BitsPerChar;
-				RDUByte8* bitBuffer = new RDUByte8[ bitBufferSize ];
+
+				if( bufferSize - newOffset < bitBufferSize )
+				{
+					return false;
+				}
+
+				// Bits are written straight into the output buffer
+				RDUByte8* bitBuffer = buffer + newOffset;
 				std::fill_n( bitBuffer, bitBufferSize, static_cast<RDUByte8>( 0x00 ) );
-				bool success = false;
 		
 				for( RDSize bit = 0; bit < m_tableSize; ++bit )
 				{
@@ -267,14 +554,9 @@ namespace Radicle { namespace SDRP
 					}
 				}
 		
-				if( Serializer::BufferPack( buffer, bufferSize, newOffset, newOffset, bitBuffer, bitBufferSize ) )
-				{
-					success = true;
-				}
-		
-				delete[] bitBuffer;
+				newOffset += bitBufferSize;
 				
-				return success;
+				return true;
 			}
 			else
 			{
@@ -291,40 +573,64 @@ namespace Radicle { namespace SDRP
 					RDSize& newOffset )
 	{
 		RDSize tableSize, hashCount;
+		FilterCodec::Encoding encoding;
 
-		if( 	Serializer::Deserialize( buffer, bufferSize, offset, newOffset, tableSize ) &&
-			Serializer::Deserialize( buffer, bufferSize, newOffset, newOffset, hashCount ) )
+		if( DeserializeHeader( buffer, bufferSize, offset, newOffset, tableSize, hashCount ) )
 		{			
-			Initialize( tableSize, hashCount );
+			Initialize( tableSize, DecodeFormat( hashCount, m_layout, m_hashing, m_reduction, encoding ) );
+
+			if( m_tableSize != tableSize )
+			{
+				RD_PRINT( "Table Size " << tableSize << " does not match the Layout and Index Reduction" );
+				return false;
+			}
 			
-			if( m_tableSize > 0 )
+			if( m_layout == Blocked && m_tableSize > 0 )
+			{
+				bool success = FilterCodec::Decode( buffer, bufferSize, newOffset, newOffset, m_table, TableBytes(), encoding );
+				Recount();
+				return success;
+			}
+			else if( m_tableSize > 0 )
 			{
-				bool success = false;
-
 				RDSize bitBufferSize = m_tableSize < BitsPerChar ? BitsPerChar : m_tableSize / BitsPerChar;
-				RDUByte8* bitBuffer = new RDUByte8[ bitBufferSize ];
-			
-				if( Serializer::BufferUnpack( buffer, bufferSize, newOffset, newOffset, bitBuffer, bitBufferSize ) )
+				ScopedBlock decoded( *m_allocator, encoding != FilterCodec::Raw ? PackedBytes( m_tableSize ) : 0 );
+
+				// Raw bits are read straight from the input buffer
+				const RDUByte8* bitBuffer = buffer + newOffset;
+
+				if( encoding == FilterCodec::Raw )
 				{
-					for( RDSize i = 0; i < m_tableSize; i++ )
+					if( bufferSize - newOffset < bitBufferSize )
 					{
-						if( CheckBit( bitBuffer, i ) )
-						{
-							Set( i );
-						}
+						RD_PRINT( "Failed to Deserialize Table Buffer" );
+						return false;
 					}
-				
-					success = true;
+
+					newOffset += bitBufferSize;
 				}
 				else
 				{
-					RD_PRINT( "Failed to Deserialize Table Buffer" );
+					RDSize packedBytes = PackedBytes( m_tableSize );
+
+					if( FilterCodec::Decode( buffer, bufferSize, newOffset, newOffset, decoded.Data(), packedBytes, encoding ) == false )
+					{
+						RD_PRINT( "Failed to Decode Table Buffer" );
+						return false;
+					}
+
+					bitBuffer = decoded.Data();
 				}
 
+				for( RDSize i = 0; i < m_tableSize; i++ )
+				{
+					if( CheckBit( bitBuffer, i ) )
+					{
+						Set( i );
+					}
+				}
 			
-				delete[] bitBuffer;
-			
-				return success;
+				return true;
 			}
 			else
 			{
@@ -341,76 +647,294 @@ namespace Radicle { namespace SDRP
 	
 	BloomFilter BloomFilter::Intersection( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
-		{
-			throw BloomFilterSizeMismatchException();
-		}
-
-		BloomFilter intersection( other.m_tableSize, other.m_hashCount );
-
-		for( RDSize i = 0; i < m_tableSize; i++ )
-		{
-			intersection.m_table[i] = Check( i ) == true && other.Check( i ) == true ? 1 : 0;
-		}
+		CheckFoldable( other );
 
-		return intersection;
+		BloomFilter intersection( *this );
+		return intersection.IntersectWith( other );
 	}
 
 	BloomFilter BloomFilter::Union( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
-		{
-			throw BloomFilterSizeMismatchException();
-		}
-
-		BloomFilter filterUnion( other.m_tableSize, other.m_hashCount );
-
-		for( RDSize i = 0; i < m_tableSize; i++ )
-		{
-			filterUnion.m_table[i] = m_table[i] + other.m_table[i];
-		}
+		CheckFoldable( other );
 
-		return filterUnion;
+		BloomFilter filterUnion( *this );
+		return filterUnion.UnionWith( other );
 	}
 	
 	RDSize BloomFilter::Difference( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
-		{
-			throw BloomFilterSizeMismatchException();
-		}
+		return XorCount( other );
+	}
 
-		RDSize difference = 0;
+	RDSize BloomFilter::SetDifference( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
+	{
+		return XorCount( other );
+	}
 
-		for( RDSize i = 0; i < m_tableSize; i++ )
+	BloomFilter& BloomFilter::UnionWith( const BloomFilter& other ) throw( BloomFilterSizeMismatchException )
+	{
+		if( Compatible( other ) == false )
 		{
-			if( Check( i ) != other.Check( i ) )
+			BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0 );
+
+			if( FoldLarger( other, folded ) )
 			{
-				difference++;
+				( *this ) = folded;
+				return UnionWith( other );
 			}
+
+			return UnionWith( folded );
 		}
-		
-		return difference;
-	}
 
-	RDSize BloomFilter::SetDifference( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
+		if( m_tableSize > 0 )
+		{
+			Unshare();
+
+			if( m_layout == Blocked )
+			{
+				FilterKernels::BitUnion( m_table, m_table, other.m_table, TableBytes() );
+			}
+			else
+			{
+				FilterKernels::CounterUnion( m_table, m_table, other.m_table, TableBytes() );
+			}
+
+			Recount();
+		}
+
+		return ( *this );
+	}
+
+	BloomFilter& BloomFilter::IntersectWith( const BloomFilter& other ) throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
+		if( Compatible( other ) == false )
 		{
-			throw BloomFilterSizeMismatchException();
+			BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0 );
+
+			if( FoldLarger( other, folded ) )
+			{
+				( *this ) = folded;
+				return IntersectWith( other );
+			}
+
+			return IntersectWith( folded );
 		}
 
-		RDSize difference = 0;
+		if( m_tableSize > 0 )
+		{
+			Unshare();
 
-		for( RDSize i = 0; i < m_tableSize; i++ )
+			if( m_layout == Blocked )
+			{
+				FilterKernels::BitIntersection( m_table, m_table, other.m_table, TableBytes() );
+			}
+			else
+			{
+				FilterKernels::CounterIntersection( m_table, m_table, other.m_table, TableBytes() );
+			}
+
+			Recount();
+		}
+
+		return ( *this );
+	}
+
+	BloomFilter& BloomFilter::SubtractWith( const BloomFilter& other ) throw( BloomFilterSizeMismatchException )
+	{
+		if( Compatible( other ) == false )
 		{
-			if( Check( i ) != other.Check( i ) )
+			BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0 );
+
+			if( FoldLarger( other, folded ) )
 			{
-				difference++;
+				( *this ) = folded;
+				return SubtractWith( other );
 			}
+
+			return SubtractWith( folded );
 		}
-		
-		return difference;
+
+		if( m_tableSize > 0 )
+		{
+			Unshare();
+
+			if( this != &other && m_layout == Blocked )
+			{
+				FilterKernels::BitSubtract( m_table, other.m_table, TableBytes() );
+			}
+			else if( this != &other )
+			{
+				FilterKernels::CounterSubtract( m_table, other.m_table, TableBytes() );
+			}
+			else
+			{
+				Clear();
+			}
+
+			Recount();
+		}
+
+		return ( *this );
+	}
+
+	RDSize BloomFilter::XorCount( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
+	{
+		if( Compatible( other ) == false )
+		{
+			BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0 );
+			return FoldLarger( other, folded ) ? folded.XorCount( other ) : XorCount( folded );
+		}
+
+		return m_layout == Blocked ? 	FilterKernels::BitDifference( m_table, other.m_table, TableBytes() ) :
+						FilterKernels::CounterDifference( m_table, other.m_table, TableBytes() );
+	}
+
+	RDDouble BloomFilter::Similarity( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
+	{
+		if( Compatible( other ) == false )
+		{
+			BloomFilter folded( ( RDSize ) 0, ( RDSize ) 0 );
+			return FoldLarger( other, folded ) ? folded.Similarity( other ) : Similarity( folded );
+		}
+
+		// Slots set in either filter follow from those set in each and those set in exactly one
+		RDSize either = ( m_population + other.m_population + XorCount( other ) ) / 2;
+		RDDouble united = Cardinality( either, m_tableSize, m_hashCount );
+
+		if( united <= 0.0 )
+		{
+			return 1.0;
+		}
+
+		RDDouble shared = EstimateCardinality() + other.EstimateCardinality() - united;
+		RDDouble similarity = shared / united;
+
+		return similarity < 0.0 ? 0.0 : ( similarity > 1.0 ? 1.0 : similarity );
+	}
+
+	const RDSize BloomFilter::Digest() const
+	{
+		if( m_digested )
+		{
+			return m_digest;
+		}
+
+		RDSize geometry[] = { m_tableSize, m_hashCount, m_layout, m_hashing, m_reduction };
+		m_digest = MurmurHash::Hash64( reinterpret_cast<const RDUByte8*>( geometry ), sizeof( geometry ), 0 );
+
+		if( m_layout == Blocked )
+		{
+			m_digest = MurmurHash::Hash64( m_table, static_cast<RDUInt32>( TableBytes() ), m_digest );
+		}
+		else
+		{
+			// Counters are reduced to one bit per slot, so filters holding the same slots set
+			// digest alike whatever their counts
+			RDUByte8 bits[ DigestChunkBytes ];
+			RDSize tableBytes = TableBytes();
+
+			for( RDSize first = 0; first < tableBytes; first += DigestChunkBytes * 4 )
+			{
+				RDSize chunkBytes = 0;
+
+				for( RDSize i = first; i < tableBytes && i < first + DigestChunkBytes * 4; i += 4, chunkBytes++ )
+				{
+					bits[ chunkBytes ] = 0x00;
+
+					for( RDSize j = 0; j < 4 && i + j < tableBytes; j++ )
+					{
+						bits[ chunkBytes ] |= static_cast<RDUByte8>( ( ( m_table[ i + j ] & 0x0F ) != 0 ? 1 : 0 ) << ( 2 * j ) );
+						bits[ chunkBytes ] |= static_cast<RDUByte8>( ( ( m_table[ i + j ] & 0xF0 ) != 0 ? 2 : 0 ) << ( 2 * j ) );
+					}
+				}
+
+				m_digest = MurmurHash::Hash64( bits, static_cast<RDUInt32>( chunkBytes ), m_digest );
+			}
+		}
+
+		m_digested = true;
+		return m_digest;
+	}
+
+	bool BloomFilter::DifferingSlots( const BloomFilter& other, std::vector<RDSize>& slots ) const
+	{
+		slots.clear();
+
+		if( Compatible( other ) == false || m_hashCount != other.m_hashCount )
+		{
+			return false;
+		}
+
+		RDSize tableBytes = TableBytes();
+
+		for( RDSize i = 0; i < tableBytes; i++ )
+		{
+			// Filters differ in few places, so equal bytes are skipped whole
+			if( m_table[ i ] == other.m_table[ i ] )
+			{
+				continue;
+			}
+
+			if( m_layout == Blocked )
+			{
+				RDUByte8 differing = static_cast<RDUByte8>( m_table[ i ] ^ other.m_table[ i ] );
+
+				for( RDSize bit = 0; bit < BitsPerChar; bit++ )
+				{
+					if( ( differing >> bit ) & 1 )
+					{
+						slots.push_back( i * BitsPerChar + bit );
+					}
+				}
+			}
+			else
+			{
+				for( RDSize counter = 0; counter < 2; counter++ )
+				{
+					RDUByte8 mine = ( m_table[ i ] >> ( counter << 2 ) ) & CounterMaximum;
+					RDUByte8 theirs = ( other.m_table[ i ] >> ( counter << 2 ) ) & CounterMaximum;
+
+					if( ( mine == 0 ) != ( theirs == 0 ) )
+					{
+						slots.push_back( ( i << 1 ) + counter );
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	BloomFilter& BloomFilter::Flip( const std::vector<RDSize>& slots )
+	{
+		Unshare();
+
+		for( RDSize i = 0; i < slots.size(); i++ )
+		{
+			RDSize slot = slots[ i ];
+
+			if( slot >= m_tableSize )
+			{
+				continue;
+			}
+
+			if( SlotValue( slot ) == 0 )
+			{
+				Set( slot );
+			}
+			else if( m_layout == Blocked )
+			{
+				m_table[ slot / BitsPerChar ] &= static_cast<RDUByte8>( ~( 1 << ( slot % BitsPerChar ) ) );
+				m_population--;
+			}
+			else
+			{
+				m_table[ slot >> 1 ] &= static_cast<RDUByte8>( ~( CounterMaximum << ( ( slot & 1 ) << 2 ) ) );
+				m_population--;
+			}
+		}
+
+		return ( *this );
 	}
 	
 	void BloomFilter::Print( std::ostream& out ) const
@@ -430,64 +954,602 @@ namespace Radicle { namespace SDRP
 		out << std::endl;
 	}
 	
+	bool BloomFilter::Tabulate()
+	{
+		RDSize tableSize, hashCount;
+
+		for( RDSize rate = 0; rate < TabulatedRates; rate++ )
+		{
+			for( RDSize elements = 0; elements < TabulatedElements; elements++ )
+			{
+				ComputeParameters( elements, TabulatedRate[ rate ], tableSize, hashCount );
+				TabulatedTableSize[ rate ][ elements ] = static_cast<RDUInt32>( tableSize );
+				TabulatedHashCount[ rate ][ elements ] = static_cast<RDUInt32>( hashCount );
+			}
+		}
+
+		return true;
+	}
+
 	void BloomFilter::CalculateParameters( 	const RDSize numElements, 
 						const RDDouble falsePositiveRate, 
 						RDSize& tableSize,
 						RDSize& hashCount )
 	{
-		std::pair<RDSize, RDDouble> parameters( numElements, falsePositiveRate );
-		
-		if( m_cachedParameters.find( parameters ) == m_cachedParameters.end() )
-		{
-	      		tableSize	= static_cast<int>(  -( numElements * std::log( falsePositiveRate ) ) / std::pow( std::log( 2.0 ), 2 ) );
-			hashCount	= ( tableSize / numElements ) * std::log( 2.0 );
-	      		
-	      		std::pair<RDSize, RDSize> result( hashCount, tableSize );
-	      		
-	      		m_cachedParameters[ parameters ] = result;
-      		}
-      		else
-      		{
-      			std::pair<RDSize, RDSize> result = m_cachedParameters[ parameters ];
-      			
-      			hashCount = result.first;
-      			tableSize = result.second;
-      		}
-      		
-      		tableSize = tableSize % BitsPerChar == 0 ? tableSize : tableSize + ( BitsPerChar - tableSize % BitsPerChar );
+		bool tabulated = false;
+
+		// The table is only written during static initialization, so reads need no locking
+		if( Tabulated && numElements < TabulatedElements )
+		{
+			for( RDSize rate = 0; rate < TabulatedRates && tabulated == false; rate++ )
+			{
+				if( TabulatedRate[ rate ] == falsePositiveRate )
+				{
+					tableSize = TabulatedTableSize[ rate ][ numElements ];
+					hashCount = TabulatedHashCount[ rate ][ numElements ];
+					tabulated = true;
+				}
+			}
+		}
+
+		if( tabulated == false )
+		{
+			ComputeParameters( numElements, falsePositiveRate, tableSize, hashCount );
+		}
+
+		if( PowerOfTwoSizes && tableSize > 0 )
+		{
+			// The hash count stays that of the unrounded table, the extra slots only lowering the false positive rate
+			RDSize powerOfTwo = BitsPerChar;
+
+			while( powerOfTwo < tableSize )
+			{
+				powerOfTwo <<= 1;
+			}
+
+			tableSize = powerOfTwo;
+		}
+	}
+
+	void BloomFilter::ComputeParameters( 	const RDSize numElements, 
+						const RDDouble falsePositiveRate, 
+						RDSize& tableSize,
+						RDSize& hashCount )
+	{
+		if( numElements == 0 )
+		{
+			tableSize = 0;
+			hashCount = 0;
+			return;
+		}
+
+		tableSize	= static_cast<int>(  -( numElements * std::log( falsePositiveRate ) ) / std::pow( std::log( 2.0 ), 2 ) );
+		hashCount	= ( tableSize / numElements ) * std::log( 2.0 );
+		tableSize	= tableSize % BitsPerChar == 0 ? tableSize : tableSize + ( BitsPerChar - tableSize % BitsPerChar );
 	}
 	
 	void BloomFilter::Initialize( const RDSize tableSize, const RDSize hashCount )
 	{	
 		m_hashCount = hashCount;
-		m_tableSize = tableSize;
+		m_tableSize = AlignedTableSize( tableSize, m_layout, m_reduction );
+		m_population = 0;
+		m_digested = false;
+
+		RDSize tableBytes = TableBytes();
 
-		if( m_table != NULL )
+		// An unshared heap table of the right size is reused rather than reallocated
+		if( m_references != NULL && ( *m_references > 1 || tableBytes <= InlineBytes || tableBytes != m_capacity ) )
 		{
-			delete[] m_table;
-			m_table = NULL;	
+			Release();
 		}
-	
-		if( m_tableSize > 0 )
+
+		if( m_tableSize == 0 )
+		{
+			m_table = NULL;
+		}
+		else if( tableBytes <= InlineBytes )
+		{
+			m_table = m_inline;
+		}
+		else if( m_references == NULL )
 		{		
-			m_table = new RDUByte8[ static_cast<RDUInt32>( m_tableSize ) ];
+			Allocate( tableBytes );
 		}
 
 		if( m_tableSize > 0 )
 		{
-			std::fill_n( m_table, m_tableSize, static_cast<RDUByte8>( 0x00 ) );
+			std::fill_n( m_table, tableBytes, static_cast<RDUByte8>( 0x00 ) );
 		}
 	}
-	
+
+	RDSize BloomFilter::AlignedTableSize( const RDSize tableSize, const TableLayout layout, const IndexReduction reduction )
+	{
+		RDSize aligned = tableSize;
+
+		if( layout == Blocked && aligned > 0 )
+		{
+			// Small tables form a single block, larger ones are padded out to whole blocks
+			RDSize alignment = aligned <= BlockSlots ? BitsPerChar : BlockSlots;
+			aligned = aligned % alignment == 0 ? aligned : aligned + ( alignment - aligned % alignment );
+		}
+
+		if( reduction == MaskReduction && aligned > 0 )
+		{
+			RDSize powerOfTwo = BitsPerChar;
+
+			while( powerOfTwo < aligned )
+			{
+				powerOfTwo <<= 1;
+			}
+
+			aligned = powerOfTwo;
+		}
+
+		return aligned;
+	}
+
+	bool BloomFilter::SerializeHeader( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset,
+						const RDSize tableSize,
+						const RDSize serializedHashCount )
+	{
+		if( CompactHeaders == false )
+		{
+			return 	Serializer::Serialize( buffer, bufferSize, offset, newOffset, tableSize ) &&
+				Serializer::Serialize( buffer, bufferSize, newOffset, newOffset, serializedHashCount );
+		}
+
+		RDSize hashCount = serializedHashCount & ( ( static_cast<RDSize>( 1 ) << FormatFlagShift ) - 1 );
+		RDUByte8 formatFlags = static_cast<RDUByte8>( serializedHashCount >> FormatFlagShift );
+		RDUByte8 lead = 	CompactHeaderMarker | static_cast<RDUByte8>( CompactHeaderVersion << 4 ) | 
+					static_cast<RDUByte8>( hashCount < HashCountEscape ? hashCount : HashCountEscape );
+
+		return 	Serializer::Serialize( buffer, bufferSize, offset, newOffset, lead ) &&
+			Serializer::Serialize( buffer, bufferSize, newOffset, newOffset, formatFlags ) &&
+			Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, tableSize ) &&
+			( hashCount < HashCountEscape || Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, hashCount ) );
+	}
+
+	bool BloomFilter::DeserializeHeader( 	const RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset,
+						RDSize& tableSize,
+						RDSize& serializedHashCount )
+	{
+		RDUByte8 lead, formatFlags;
+
+		if( Serializer::Deserialize( buffer, bufferSize, offset, newOffset, lead ) == false )
+		{
+			return false;
+		}
+
+		// Legacy headers begin with the most significant byte of a 64-bit table size
+		if( lead == 0 )
+		{
+			return 	Serializer::Deserialize( buffer, bufferSize, offset, newOffset, tableSize ) &&
+				Serializer::Deserialize( buffer, bufferSize, newOffset, newOffset, serializedHashCount );
+		}
+
+		if( ( lead & 0x70 ) != static_cast<RDUByte8>( CompactHeaderVersion << 4 ) )
+		{
+			RD_PRINT( "Unsupported Compact Header Version " << ( ( lead & 0x70 ) >> 4 ) );
+			return false;
+		}
+
+		RDSize hashCount = lead & HashCountEscape;
+
+		if( 	Serializer::Deserialize( buffer, bufferSize, newOffset, newOffset, formatFlags ) &&
+			Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, tableSize ) &&
+			( hashCount < HashCountEscape || Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, hashCount ) ) &&
+			( hashCount >> FormatFlagShift ) == 0 )
+		{
+			serializedHashCount = hashCount | ( static_cast<RDSize>( formatFlags ) << FormatFlagShift );
+			return true;
+		}
+
+		return false;
+	}
+
+	RDSize BloomFilter::PackedBytes( const RDSize tableSize )
+	{
+		return tableSize < BitsPerChar ? BitsPerChar : ( tableSize + BitsPerChar - 1 ) / BitsPerChar;
+	}
+
+	RDSize BloomFilter::EncodeFormat( 	const RDSize hashCount, 
+						const TableLayout layout, 
+						const HashScheme hashing, 
+						const IndexReduction reduction,
+						const FilterCodec::Encoding encoding )
+	{
+		RDSize formatFlags = 	( layout == Blocked ? BlockedFormatFlag : 0 ) |
+					( hashing == DoubleHashing ? DoubleHashingFormatFlag : 0 ) |
+					( reduction == MaskReduction ? MaskFormatFlag : 0 ) |
+					( reduction == MultiplyShiftReduction ? MultiplyShiftFormatFlag : 0 ) |
+					( encoding == FilterCodec::RunLength ? RunLengthFormatFlag : 0 ) |
+					( encoding == FilterCodec::Golomb ? GolombFormatFlag : 0 );
+
+		return hashCount | ( formatFlags << FormatFlagShift );
+	}
+
+	RDSize BloomFilter::DecodeFormat( 	const RDSize serializedHashCount, 
+						TableLayout& layout, 
+						HashScheme& hashing, 
+						IndexReduction& reduction,
+						FilterCodec::Encoding& encoding )
+	{
+		RDSize formatFlags = serializedHashCount >> FormatFlagShift;
+
+		layout = ( formatFlags & BlockedFormatFlag ) != 0 ? Blocked : Counting;
+		hashing = ( formatFlags & DoubleHashingFormatFlag ) != 0 ? DoubleHashing : ChainedHashing;
+		reduction = 	( formatFlags & MaskFormatFlag ) != 0 ? MaskReduction : 
+				( formatFlags & MultiplyShiftFormatFlag ) != 0 ? MultiplyShiftReduction : ModuloReduction;
+		encoding = 	( formatFlags & RunLengthFormatFlag ) != 0 ? FilterCodec::RunLength :
+				( formatFlags & GolombFormatFlag ) != 0 ? FilterCodec::Golomb : FilterCodec::Raw;
+
+		return serializedHashCount & ( ( static_cast<RDSize>( 1 ) << FormatFlagShift ) - 1 );
+	}
+
+	void BloomFilter::Allocate( const RDSize tableBytes )
+	{
+		m_references = static_cast<RDSize*>( m_allocator->Allocate( BlockBytes( tableBytes ) ) );
+		*m_references = 1;
+		m_table = reinterpret_cast<RDUByte8*>( m_references + 1 );
+		m_capacity = tableBytes;
+	}
+
+	void BloomFilter::Release()
+	{
+		if( m_references != NULL && --( *m_references ) == 0 )
+		{
+			m_allocator->Release( m_references, BlockBytes( m_capacity ) );
+		}
+
+		m_references = NULL;
+		m_table = NULL;
+		m_capacity = 0;
+	}
+
+	RDSize BloomFilter::BlockBytes( const RDSize tableBytes )
+	{
+		return sizeof( RDSize ) * ( 1 + ( tableBytes + sizeof( RDSize ) - 1 ) / sizeof( RDSize ) );
+	}
+
+	void BloomFilter::Unshare()
+	{
+		// Tables are only written once unshared, so this is where the digest goes stale
+		m_digested = false;
+
+		if( m_references != NULL && *m_references > 1 )
+		{
+			const RDUByte8* shared = m_table;
+			--( *m_references );
+			Allocate( m_capacity );
+			memcpy( m_table, shared, m_capacity );
+		}
+	}
+
+	void BloomFilter::CheckFoldable( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
+	{
+		if( Foldable( other ) == false )
+		{
+			throw BloomFilterSizeMismatchException();
+		}
+	}
+
+	bool BloomFilter::FoldsTo( const RDSize tableSize ) const
+	{
+		if( tableSize == m_tableSize )
+		{
+			return true;
+		}
+
+		if( tableSize == 0 || tableSize > m_tableSize || m_tableSize % tableSize != 0 )
+		{
+			return false;
+		}
+
+		if( m_layout == Blocked )
+		{
+			// Folded blocked tables must keep whole bytes and blocks. Double hashing steps depend on
+			// the block count, so those filters fold only within a single block.
+			if( tableSize % ( tableSize <= BlockSlots ? BitsPerChar : BlockSlots ) != 0 )
+			{
+				return false;
+			}
+
+			// Tables spanning several blocks fold to a single block first, which only folds further
+			// to a size dividing it
+			if( m_tableSize > BlockSlots && tableSize < BlockSlots && BlockSlots % tableSize != 0 )
+			{
+				return false;
+			}
+
+			return m_hashing == ChainedHashing || m_tableSize <= BlockSlots;
+		}
+
+		return m_reduction != MaskReduction || ( tableSize & ( tableSize - 1 ) ) == 0;
+	}
+
+	RDSize BloomFilter::FoldSlot( const RDSize slot, const RDSize tableSize ) const
+	{
+		RDSize from = m_tableSize, index = slot;
+
+		if( m_layout == Blocked && m_tableSize > BlockSlots )
+		{
+			// Blocks fold onto blocks, each keeping its offset, until a single block remains to fold
+			RDSize blocks = m_tableSize / BlockSlots;
+			RDSize foldedBlocks = tableSize > BlockSlots ? tableSize / BlockSlots : 1;
+			RDSize block = m_reduction == MultiplyShiftReduction ? ( slot / BlockSlots ) / ( blocks / foldedBlocks ) : ( slot / BlockSlots ) % foldedBlocks;
+
+			if( tableSize >= BlockSlots )
+			{
+				return block * BlockSlots + slot % BlockSlots;
+			}
+
+			from = BlockSlots;
+			index = slot % BlockSlots;
+		}
+
+		// Reducing a hash to a range and then to a divisor of that range reaches the same index as
+		// reducing it to the divisor directly
+		return m_reduction == MultiplyShiftReduction ? index / ( from / tableSize ) : index % tableSize;
+	}
+
+	bool BloomFilter::FoldLarger( const BloomFilter& other, BloomFilter& folded ) const throw( BloomFilterSizeMismatchException )
+	{
+		CheckFoldable( other );
+
+		if( m_tableSize >= other.m_tableSize )
+		{
+			folded = ( *this );
+			folded.Fold( other.m_tableSize );
+			return true;
+		}
+
+		folded = other;
+		folded.Fold( m_tableSize );
+		return false;
+	}
+
+	bool BloomFilter::Compatible( const BloomFilter& other ) const
+	{
+		return 	m_tableSize == other.m_tableSize && m_layout == other.m_layout && 
+			m_hashing == other.m_hashing && m_reduction == other.m_reduction;
+	}
+
+	RDDouble BloomFilter::Cardinality( const RDSize population, const RDSize tableSize, const RDSize hashCount )
+	{
+		if( tableSize == 0 || hashCount == 0 )
+		{
+			return 0.0;
+		}
+
+		// n = -( m / k ) ln( 1 - X / m ), for X of m slots set
+		RDDouble slots = static_cast<RDDouble>( tableSize );
+		RDDouble set = static_cast<RDDouble>( population < tableSize ? population : tableSize - 1 );
+
+		return -( slots / hashCount ) * std::log( 1.0 - set / slots );
+	}
+
+	RDSize BloomFilter::TableBytes() const
+	{
+		return m_layout == Blocked ? m_tableSize / BitsPerChar : ( m_tableSize + 1 ) / 2;
+	}
+
+	BloomFilter::Probe::Probe( const BloomFilter& filter, const RDIdentifier id ) :
+	m_id( id ),
+	m_hashing( filter.m_hashing ),
+	m_reduction( filter.m_reduction ),
+	m_base( 0 ),
+	m_span( filter.m_tableSize ),
+	m_hash( 0 ),
+	m_step( 0 )
+	{
+		Start( filter.m_tableSize, filter.m_layout );
+	}
+
+	BloomFilter::Probe::Probe( 	const RDSize tableSize, 
+					const TableLayout layout, 
+					const HashScheme hashing, 
+					const IndexReduction reduction, 
+					const RDIdentifier id ) :
+	m_id( id ),
+	m_hashing( hashing ),
+	m_reduction( reduction ),
+	m_base( 0 ),
+	m_span( tableSize ),
+	m_hash( 0 ),
+	m_step( 0 )
+	{
+		Start( tableSize, layout );
+	}
+
+	void BloomFilter::Probe::Start( const RDSize tableSize, const TableLayout layout )
+	{
+		RDSize blocks = 1;
+
+		if( layout == Blocked && tableSize > BlockSlots )
+		{
+			blocks = tableSize / BlockSlots;
+			m_span = BlockSlots;
+		}
+
+		if( m_hashing == DoubleHashing )
+		{
+			// The upper half selects the block and the step, the lower half seeds the probes
+			RDSize hash = MurmurHash::Hash64( m_id, 0 );
+			RDSize upper = hash >> 32;
+
+			if( m_reduction == MultiplyShiftReduction )
+			{
+				// The bits below the selected block are as well mixed as the block index itself
+				m_base = ( ( upper * blocks ) >> 32 ) * m_span;
+				m_step = ( ( upper * blocks ) & 0xFFFFFFFF ) | 1;
+			}
+			else
+			{
+				m_base = Reduce( upper, blocks, m_reduction ) * m_span;
+				m_step = ( blocks > 1 ? upper / blocks : upper ) | 1;
+			}
+
+			m_hash = hash & 0xFFFFFFFF;
+		}
+		else if( blocks > 1 )
+		{
+			m_base = Reduce( MurmurHash::Hash( m_id, static_cast<RDUInt32>( BlockSlots ) ), blocks, m_reduction ) * m_span;
+		}
+	}
+
+	RDSize BloomFilter::Probe::Next()
+	{
+		if( m_hashing == DoubleHashing )
+		{
+			RDSize slot = m_base + Reduce( m_hash, m_span, m_reduction );
+			m_hash += m_step;
+			return slot;
+		}
+
+		m_hash = MurmurHash::Hash( m_id, static_cast<RDUInt32>( m_hash ) );
+		return m_base + Reduce( m_hash, m_span, m_reduction );
+	}
+
+	void BloomFilter::BatchProbes( const RDIdentifier* ids, const RDSize count, RDSize* slots ) const
+	{
+		// Chained probes over a single region depend only on the identifier and the previous hash,
+		// so each round of hashes is computed across the whole batch at once
+		if( m_hashing == ChainedHashing && ( m_layout == Counting || m_tableSize <= BlockSlots ) )
+		{
+			RDUInt32 hashes[ BatchSize ] = { 0 };
+
+			for( RDSize j = 0; j < m_hashCount; j++ )
+			{
+				MurmurHash::HashMany( ids, hashes, count );
+
+				for( RDSize i = 0; i < count; i++ )
+				{
+					slots[ i * m_hashCount + j ] = Reduce( hashes[ i ], m_tableSize, m_reduction );
+				}
+			}
+		}
+		else
+		{
+			for( RDSize i = 0; i < count; i++ )
+			{
+				Probe probe( *this, ids[ i ] );
+
+				for( RDSize j = 0; j < m_hashCount; j++ )
+				{
+					slots[ i * m_hashCount + j ] = probe.Next();
+				}
+			}
+		}
+
+		RDSize slotsPerByte = m_layout == Blocked ? BitsPerChar : 2;
+
+		for( RDSize i = 0; i < count * m_hashCount; i++ )
+		{
+			Prefetch( m_table + slots[ i ] / slotsPerByte );
+		}
+	}
+
+	RDSize BloomFilter::Reduce( const RDSize hash, const RDSize range, const IndexReduction reduction )
+	{
+		switch( reduction )
+		{
+			case MaskReduction:
+				return hash & ( range - 1 );
+			case MultiplyShiftReduction:
+				return ( ( hash & 0xFFFFFFFF ) * range ) >> 32;
+			default:
+				return hash % range;
+		}
+	}
+
+	RDSize BloomFilter::Wrap( const RDSize index ) const
+	{
+		if( m_reduction == MaskReduction )
+		{
+			return index & ( m_tableSize - 1 );
+		}
+
+		// Probed indices are always within the table, so the divide is only paid by external callers
+		return index < m_tableSize ? index : index % m_tableSize;
+	}
+
+	RDUByte8 BloomFilter::SlotValue( const RDSize slot ) const
+	{
+		if( m_layout == Blocked )
+		{
+			return CheckBit( m_table, slot ) ? 1 : 0;
+		}
+
+		return ( m_table[ slot >> 1 ] >> ( ( slot & 1 ) << 2 ) ) & CounterMaximum;
+	}
+
+	void BloomFilter::Increment( const RDSize slot )
+	{
+		RDUByte8 value = SlotValue( slot );
+
+		if( value == 0 )
+		{
+			m_population++;
+		}
+
+		if( value < CounterMaximum )
+		{
+			m_table[ slot >> 1 ] += static_cast<RDUByte8>( 1 << ( ( slot & 1 ) << 2 ) );
+		}
+	}
+
+	void BloomFilter::Decrement( const RDSize slot )
+	{
+		RDUByte8 value = SlotValue( slot );
+
+		if( value > 0 && value < CounterMaximum )
+		{
+			m_table[ slot >> 1 ] -= static_cast<RDUByte8>( 1 << ( ( slot & 1 ) << 2 ) );
+
+			if( value == 1 )
+			{
+				m_population--;
+			}
+		}
+	}
+
+	void BloomFilter::Recount()
+	{
+		m_population = m_layout == Blocked ? 	FilterKernels::BitPopulation( m_table, TableBytes() ) :
+							FilterKernels::CounterPopulation( m_table, TableBytes() );
+	}
+
 	BloomFilter& BloomFilter::Set( const RDSize index )
 	{
-		m_table[ index % m_tableSize ]++;
+		Unshare();
+
+		if( m_layout == Blocked )
+		{
+			RDSize slot = Wrap( index );
+
+			if( CheckBit( m_table, slot ) == false )
+			{
+				SetBit( m_table, slot );
+				m_population++;
+			}
+		}
+		else
+		{
+			Increment( Wrap( index ) );
+		}
+
 		return ( *this );
 	}
 
 	bool BloomFilter::Check( const RDSize index ) const
 	{
-		return m_table[ index % m_tableSize ] != 0;
+		return SlotValue( Wrap( index ) ) != 0;
 	}
 	
 	bool BloomFilter::CheckBit( const RDUByte8* buffer, const RDSize bit ) const
@@ -528,9 +1590,11 @@ namespace Radicle { namespace SDRP
 	
 	bool BloomFilter::operator==( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
+		// Digests cover the hash count, so differing digests only prove differing tables when
+		// the hash counts match. Matching digests may collide, so are confirmed exactly.
+		if( Compatible( other ) && m_hashCount == other.m_hashCount && Digest() != other.Digest() )
 		{
-			throw BloomFilterSizeMismatchException();
+			return false;
 		}
 
 		return Difference( other ) == 0;
@@ -543,39 +1607,107 @@ namespace Radicle { namespace SDRP
 	
 	bool BloomFilter::operator>( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
-		{
-			throw BloomFilterSizeMismatchException();
-		}
+		CheckFoldable( other );
 
 		return SetBytes() > other.SetBytes();
 	}
 	
 	bool BloomFilter::operator<( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException )
 	{
-		if( m_tableSize != other.m_tableSize )
-		{
-			throw BloomFilterSizeMismatchException();
-		}
+		CheckFoldable( other );
 
 		return !( ( *this ) > other );
 	}
 
+	BloomFilter& BloomFilter::operator|=( const BloomFilter& other ) throw( BloomFilterSizeMismatchException )
+	{
+		return UnionWith( other );
+	}
+
+	BloomFilter& BloomFilter::operator&=( const BloomFilter& other ) throw( BloomFilterSizeMismatchException )
+	{
+		return IntersectWith( other );
+	}
+
 	BloomFilter& BloomFilter::operator=( const BloomFilter& other )
 	{
 		if( this != &other )
 		{
-			Initialize( other.m_tableSize, other.m_hashCount );
-			memcpy( m_table, other.m_table, m_tableSize );
+			m_layout = other.m_layout;
+			m_hashing = other.m_hashing;
+			m_reduction = other.m_reduction;
+
+			if( other.m_references != NULL && ShareTables && other.m_allocator == m_allocator && m_allocator->Persistent() )
+			{
+				if( m_references != other.m_references )
+				{
+					Release();
+					m_references = other.m_references;
+					++( *m_references );
+				}
+
+				m_table = other.m_table;
+				m_capacity = other.m_capacity;
+				m_tableSize = other.m_tableSize;
+				m_hashCount = other.m_hashCount;
+			}
+			else
+			{
+				Initialize( other.m_tableSize, other.m_hashCount );
+
+				if( m_tableSize > 0 )
+				{
+					memcpy( m_table, other.m_table, TableBytes() );
+				}
+			}
+
+			m_population = other.m_population;
+			m_digest = other.m_digest;
+			m_digested = other.m_digested;
+		}
+
+		return ( *this );
+	}
+
+#ifdef RD_SDRP_MOVE_SEMANTICS
+	BloomFilter& BloomFilter::operator=( BloomFilter&& other )
+	{
+		if( this != &other && other.m_references != NULL && other.m_allocator == m_allocator )
+		{
+			Release();
+			m_layout = other.m_layout;
+			m_hashing = other.m_hashing;
+			m_reduction = other.m_reduction;
+			m_references = other.m_references;
+			m_table = other.m_table;
+			m_capacity = other.m_capacity;
+			m_tableSize = other.m_tableSize;
+			m_hashCount = other.m_hashCount;
+			m_population = other.m_population;
+			m_digest = other.m_digest;
+			m_digested = other.m_digested;
+
+			other.m_references = NULL;
+			other.m_table = NULL;
+			other.m_capacity = 0;
+			other.m_tableSize = 0;
+			other.m_hashCount = 0;
+			other.m_population = 0;
+			other.m_digested = false;
 		}
+		else
+		{
+			// Inline tables are no cheaper to move than to copy
+			( *this ) = static_cast<const BloomFilter&>( other );
+		}
+
+		return ( *this );
 	}
+#endif
 	
 	BloomFilter::~BloomFilter()
 	{	
-		if( m_table != NULL )
-		{
-			delete[] m_table;
-		}
+		Release();
 	}
 } }
 
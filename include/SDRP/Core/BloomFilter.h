@@ -11,11 +11,14 @@
 #ifndef RD_SDRP_BLOOM_FILTER_H
 #define RD_SDRP_BLOOM_FILTER_H
 
-#include <map>
 #include <iostream>
+#include <vector>
 #include <SDRP/Core/Types.h>
+#include <SDRP/Core/Definitions.h>
 #include <SDRP/Core/Exception.h>
+#include <SDRP/Core/IAllocator.h>
 #include <SDRP/Core/ISerializable.h>
+#include <SDRP/Utilities/FilterCodec.h>
 
 namespace Radicle { namespace SDRP
 {
@@ -36,6 +39,8 @@ namespace Radicle { namespace SDRP
 		}
 	};
 
+	template< RDSize Slots, RDSize Hashes > class FixedBloomFilter;
+
 	/**
 	 *	A Bloom Filter is a static-length set representation which may
 	 *	be used to check for the presence of data but which may not retrieve
@@ -44,13 +49,68 @@ namespace Radicle { namespace SDRP
 	class BloomFilter : public ISerializable
 	{
 	public:
+
+		/// Table Layouts
+		enum TableLayout
+		{
+			/// One 4-bit counter per slot, two slots to a byte. Supports removal of individual 
+			/// elements. Counters saturate at 15 and are never decremented once saturated.
+			Counting,
+			/// One bit per slot, with all probes for an element confined to a single cache-line
+			/// sized block. Does not support removal of individual elements.
+			Blocked
+		};
+
+		/// Hashing Schemes
+		enum HashScheme
+		{
+			/// Each probe hashes the identifier again, seeded with the previous probe's hash
+			ChainedHashing,
+			/// All probes are derived from a single 64-bit hash as h1 + i * h2
+			DoubleHashing
+		};
+
+		/// Schemes for reducing a hash to a slot index
+		enum IndexReduction
+		{
+			/// Hashes are reduced with an integer modulo of the table size
+			ModuloReduction,
+			/// Tables are rounded up to a power of two and hashes are reduced with a bit mask
+			MaskReduction,
+			/// Hashes are scaled into the table range with a multiply and shift
+			MultiplyShiftReduction
+		};
 		
 		/// Number of Bits in a Char Type
 		const static RDSize		BitsPerChar;
+		/// Number of Slots in a Blocked Layout Block (One 64-byte Cache Line)
+		const static RDSize		BlockSlots;
+		/// Number of Table Bytes held without heap allocation
+		const static RDSize		InlineBytes;
 		/// Predicted Number of Contained Elements
 		static RDSize 			PredictedElementCount;
 		/// Desired False Positive Rate
 		static RDDouble			DesiredFalsePositiveRate;
+		/// Layout used for filters which only ever answer membership queries
+		static TableLayout		MembershipLayout;
+		/// Indicates whether copies of heap allocated tables share storage until either is modified
+		static bool			ShareTables;
+		/// Indicates whether serialized tables are compressed when a compressed encoding is smaller.
+		/// Off by default, as nodes predating compressed encodings cannot read them.
+		static bool			CompressTables;
+		/// Indicates whether filters are serialized with compact varint headers rather than the
+		/// legacy fixed-width header. Either is accepted when deserializing. Off by default, as
+		/// nodes predating compact headers cannot read them.
+		static bool			CompactHeaders;
+		/// Allocator given to new filters for their heap tables, the shared PoolAllocator by default
+		static IAllocator*		DefaultAllocator;
+		/// Indicates whether tables sized from an element count are rounded up to a power of two,
+		/// such that any two filters built alike may be folded to a common size
+		static bool			PowerOfTwoSizes;
+		/// Hashing scheme used by newly constructed filters
+		static HashScheme		DefaultHashScheme;
+		/// Index reduction used by newly constructed filters
+		static IndexReduction		DefaultReduction;
 		/// Simple Empty Bloom Filter
 		static const BloomFilter	Empty;
 				
@@ -58,16 +118,19 @@ namespace Radicle { namespace SDRP
 		 *	Default Constructor
 		 * @param numElements		Number of Elements to be Contained
 		 * @param falsePositiveRate	Maximum False Positive Rate
+		 * @param layout		Table Layout
 		 */
 		BloomFilter( 	const RDSize numElements = PredictedElementCount, 
-				const RDDouble falsePositiveRate = DesiredFalsePositiveRate );
+				const RDDouble falsePositiveRate = DesiredFalsePositiveRate,
+				const TableLayout layout = Counting );
 				
 		/**
 		 *	Initializing Constructor
 		 * @param tableSize	Table Size in Bits
 		 * @param hashCount	Number of hashes to use per insertion
+		 * @param layout	Table Layout
 		 */
-		BloomFilter(	const RDSize tableSize, const RDSize hashCount );
+		BloomFilter(	const RDSize tableSize, const RDSize hashCount, const TableLayout layout = Counting );
 		
 		/**
 		 *	Copy Constructor
@@ -75,6 +138,14 @@ namespace Radicle { namespace SDRP
 		 */
 		BloomFilter(	const BloomFilter& other );
 
+#ifdef RD_SDRP_MOVE_SEMANTICS
+		/**
+		 *	Move Constructor. Takes ownership of the table of \a other, leaving it empty.
+		 * @param other	Other Bloom Filter
+		 */
+		BloomFilter(	BloomFilter&& other );
+#endif
+
 		/**
 		 *	Reset the bloom filter with new parameters
 		 * @param numElements		Number of Elements to be Contained
@@ -95,6 +166,22 @@ namespace Radicle { namespace SDRP
 		 * @return	True - If the bloom filter contains the identifier. False otherwise.
 		 */
 		bool Contains( const RDIdentifier id ) const;
+
+		/**
+		 *	Insert many identifiers into the bloom filter. The probes for a batch of identifiers are
+		 *	hashed together and their slots prefetched before any of them are set.
+		 * @param ids	Identifiers to be inserted
+		 * @param count	Number of identifiers
+		 */
+		BloomFilter& InsertMany( const RDIdentifier* ids, const RDSize count );
+
+		/**
+		 *	Check whether the bloom filter contains each of many identifiers
+		 * @param ids		Identifiers to be checked
+		 * @param count		Number of identifiers
+		 * @param results	Output. Set to whether the filter contains the identifier at the same index.
+		 */
+		void ContainsMany( const RDIdentifier* ids, const RDSize count, bool* results ) const;
 		
 		/**
 		 *	Check whether the bloom filter contains all of the elements in the given filter
@@ -104,7 +191,8 @@ namespace Radicle { namespace SDRP
 		bool Contains( const BloomFilter& filter ) const;
 		
 		/**
-		 *	Remove the provided identifer from the bloom filter
+		 *	Remove the provided identifer from the bloom filter. Blocked filters cannot forget 
+		 *	individual elements and are left unchanged.
 		 * @param id	Identifier to be removed
 		 */
 		BloomFilter& Remove( const RDIdentifier id );
@@ -126,6 +214,23 @@ namespace Radicle { namespace SDRP
 		 * @param hashCount	New Hash Count
 		 */
 		BloomFilter& DestructiveResize( const RDSize tableSize, const RDSize hashCount );
+
+		/**
+		 *	Fold the filter down to a smaller table which its size is a multiple of. Each slot is
+		 *	merged into the slot it would have been probed as in the smaller table, so the folded
+		 *	filter contains every element this filter did. Counters are summed.
+		 * @param tableSize	New Table Size
+		 */
+		BloomFilter& Fold( const RDSize tableSize ) throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Check whether this filter and another may be combined or compared, the larger being
+		 *	folded to the size of the smaller where their sizes differ
+		 * @param other	Other Bloom Filter
+		 * @return	True - If both filters share layout, hashing scheme and index reduction and
+		 *		one may be folded to the size of the other. False otherwise.
+		 */
+		bool Foldable( const BloomFilter& other ) const;
 		
 		/**
 		 *	Check whether the removal of the elements contained in \a other would result in a change
@@ -136,11 +241,18 @@ namespace Radicle { namespace SDRP
 		bool RemovalResultsInDifference( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
 		
 		/**
-		 *	Check whether this bloom filter contains any elements
+		 *	Check whether this bloom filter contains any elements. Maintained as slots are set and cleared.
 		 * @return	True - If the bloom filter contains any elements. False otherwise.
 		 */
 		bool HasElements() const;
 		
+		/**
+		 *	Estimate the number of distinct elements inserted into the filter from the fraction of
+		 *	slots set. A full table gives the estimate for all but one slot being set.
+		 * @return	Estimated Element Count
+		 */
+		RDDouble EstimateCardinality() const;
+
 		/**
 		 *	Get the size of the filter in bytes
 		 * @return	Size of the filter in bytes
@@ -152,6 +264,39 @@ namespace Radicle { namespace SDRP
 		 * @return 	Hash count
 		 */
 		const RDSize HashCount() const;
+
+		/**
+		 *	Get the allocator from which the filter's heap table is allocated
+		 * @return	Table Allocator
+		 */
+		IAllocator& Allocator() const;
+
+		/**
+		 *	Allocate the filter's heap table from the given allocator, moving any table held.
+		 *	Filters only share tables from the same persistent allocator, so a copy of a filter
+		 *	allocated from a scratch arena has a table of its own and may outlive the arena.
+		 * @param allocator	Table Allocator
+		 * @return		This filter
+		 */
+		BloomFilter& Allocator( IAllocator& allocator );
+
+		/**
+		 *	Get the layout of the filter table
+		 * @return	Table Layout
+		 */
+		const TableLayout Layout() const;
+
+		/**
+		 *	Get the scheme used to derive probe indices from identifiers
+		 * @return	Hashing Scheme
+		 */
+		const HashScheme Hashing() const;
+
+		/**
+		 *	Get the scheme used to reduce hashes to slot indices
+		 * @return	Index Reduction
+		 */
+		const IndexReduction Reduction() const;
 		
 		/**
 		 *	Clear all elements from the bloom filter
@@ -159,7 +304,7 @@ namespace Radicle { namespace SDRP
 		BloomFilter& Clear();
 		
 		/**
-		 *	Get the number of bytes set in this bloom filter
+		 *	Get the number of bytes set in this bloom filter. Maintained as slots are set and cleared.
 		 * @return	Number of bytes set in this bloom filter
 		 */
 		const RDSize SetBytes() const;
@@ -194,6 +339,75 @@ namespace Radicle { namespace SDRP
 		 *		of bits set in other that are not set in this filter.
 		 */
 		RDSize SetDifference( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Add the contents of another bloom filter to this filter in place. Where the sizes
+		 *	differ, the result takes the smaller size.
+		 * @param other	Other Bloom Filter
+		 * @return	This filter
+		 */
+		BloomFilter& UnionWith( const BloomFilter& other ) throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Reduce this filter in place to the slots also set in another bloom filter. Where the
+		 *	sizes differ, the result takes the smaller size.
+		 * @param other	Other Bloom Filter
+		 * @return	This filter
+		 */
+		BloomFilter& IntersectWith( const BloomFilter& other ) throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Remove the contents of another bloom filter from this filter in place. Where the sizes
+		 *	differ, the result takes the smaller size.
+		 * @param other	Other Bloom Filter
+		 * @return	This filter
+		 */
+		BloomFilter& SubtractWith( const BloomFilter& other ) throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Count the slots set in exactly one of this bloom filter and another, at the smaller
+		 *	of their sizes
+		 * @param other	Other Bloom Filter
+		 * @return	Number of differently set slots
+		 */
+		RDSize XorCount( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Estimate the Jaccard similarity between the elements of this bloom filter and another,
+		 *	at the smaller of their sizes. The sizes of both sets and of their union are estimated
+		 *	from the slots set in each filter and in either, giving the size of the intersection.
+		 * @param other	Other Bloom Filter
+		 * @return	Estimated ratio of the size of the intersection to the size of the union,
+		 *		between 0 and 1. Two empty filters are considered identical.
+		 */
+		RDDouble Similarity( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Get a 64-bit digest of the filter's geometry, hash count included, and of which slots are
+		 *	set. Filters with differing digests differ, but distinct filters may share a digest, so
+		 *	a matching digest does not prove two filters equal. The digest is computed when first
+		 *	requested, kept until the filter is next modified, and carried by copies of the filter.
+		 * @return	Filter Digest
+		 */
+		const RDSize Digest() const;
+
+		/**
+		 *	Find the slots set in exactly one of this bloom filter and another sharing its geometry
+		 * @param other		Other Bloom Filter
+		 * @param slots[out]	Differing Slot Indices, in ascending order
+		 * @return		True - If the filters share size, layout, hash count, hashing scheme
+		 *			and index reduction. False otherwise, leaving slots empty.
+		 */
+		bool DifferingSlots( const BloomFilter& other, std::vector<RDSize>& slots ) const;
+
+		/**
+		 *	Clear each of the given slots which is set, and set each which is clear. Applying the
+		 *	slots found by DifferingSlots to either filter gives the other. Slots beyond the end of
+		 *	the table are ignored.
+		 * @param slots	Slot Indices
+		 * @return	This filter
+		 */
+		BloomFilter& Flip( const std::vector<RDSize>& slots );
 		
 		/**
 		 *	Print the filter to the specified output stream
@@ -240,17 +454,31 @@ namespace Radicle { namespace SDRP
 						RDSize& newOffset );
 		
 		/**
-		 *	Comparison Operators
+		 *	Comparison Operators. Filters sharing their geometry and hash count are told apart by
+		 *	digest where it differs, and otherwise compared slot by slot.
 		 */	
 		bool operator==( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
 		bool operator!=( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );;
 		bool operator>( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
 		bool operator<( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
 		
+		/**
+		 *	In Place Union and Intersection Operators
+		 */
+		BloomFilter& operator|=( const BloomFilter& other ) throw( BloomFilterSizeMismatchException );
+		BloomFilter& operator&=( const BloomFilter& other ) throw( BloomFilterSizeMismatchException );
+
 		/**
 		 *	Assignment Operator
 		 */
 		BloomFilter& operator=( const BloomFilter& other );
+
+#ifdef RD_SDRP_MOVE_SEMANTICS
+		/**
+		 *	Move Assignment Operator
+		 */
+		BloomFilter& operator=( BloomFilter&& other );
+#endif
 		
 		/**
 		 *	Default Destructor
@@ -258,12 +486,108 @@ namespace Radicle { namespace SDRP
 		~BloomFilter();
 		
 	private:
+
+		/// Probe Generator
+		class Probe;
+		friend class Probe;
+		friend class BloomFilterView;
+		friend class ConcurrentBloomFilter;
+		friend class BloomFilterSet;
+		template< RDSize Slots, RDSize Hashes > friend class FixedBloomFilter;
+
+		/// Serialized format flag indicating a blocked table layout
+		const static RDSize		BlockedFormatFlag;
+		/// Serialized format flag indicating double hashing
+		const static RDSize		DoubleHashingFormatFlag;
+		/// Serialized format flag indicating mask index reduction
+		const static RDSize		MaskFormatFlag;
+		/// Serialized format flag indicating multiply-shift index reduction
+		const static RDSize		MultiplyShiftFormatFlag;
+		/// Serialized format flag indicating a run-length encoded table
+		const static RDSize		RunLengthFormatFlag;
+		/// Serialized format flag indicating a Golomb coded table
+		const static RDSize		GolombFormatFlag;
+		/// Lead byte bit marking a compact header. Legacy headers always begin with a zero byte.
+		const static RDUByte8		CompactHeaderMarker;
+		/// Compact header version, held in the three bits below the marker
+		const static RDUByte8		CompactHeaderVersion;
+		/// Lead byte hash count nibble indicating that a varint hash count follows the table size
+		const static RDUByte8		HashCountEscape;
+		/// Largest value held by a counting slot
+		const static RDUByte8		CounterMaximum;
+		/// Bit offset of the format flags within the serialized hash count
+		const static RDSize		FormatFlagShift;
+
+		/**
+		 *	Generates the sequence of slots probed for a single identifier
+		 */
+		class Probe
+		{
+		public:
+
+			/**
+			 *	Default Constructor
+			 * @param filter	Filter being probed
+			 * @param id		Identifier
+			 */
+			Probe( const BloomFilter& filter, const RDIdentifier id );
+
+			/**
+			 *	Initializing Constructor
+			 * @param tableSize	Table Size in Slots
+			 * @param layout	Table Layout
+			 * @param hashing	Hashing Scheme
+			 * @param reduction	Index Reduction
+			 * @param id		Identifier
+			 */
+			Probe( 	const RDSize tableSize, 
+				const TableLayout layout, 
+				const HashScheme hashing, 
+				const IndexReduction reduction, 
+				const RDIdentifier id );
+
+			/**
+			 *	Get the next probed slot
+			 * @return	Slot Index
+			 */
+			RDSize Next();
+
+		private:
+
+			/**
+			 *	Select the probed region and derive the initial hash
+			 * @param tableSize	Table Size in Slots
+			 * @param layout	Table Layout
+			 */
+			void Start( const RDSize tableSize, const TableLayout layout );
+
+			/// Identifier
+			RDIdentifier		m_id;
+			/// Hashing Scheme
+			HashScheme		m_hashing;
+			/// Index Reduction
+			IndexReduction		m_reduction;
+			/// First Slot of the Probed Region
+			RDSize			m_base;
+			/// Number of Slots in the Probed Region
+			RDSize			m_span;
+			/// Current Hash or Double Hashing Accumulator
+			RDSize			m_hash;
+			/// Double Hashing Step
+			RDSize			m_step;
+		};
 	
-		/// Cached Calculated Parameters
-		static std::map< std::pair<RDSize, RDDouble>, std::pair<RDSize, RDSize> > m_cachedParameters;
-	
+		/// Indicates whether the parameter table has been built. Calculated at startup.
+		static bool Tabulated;
+
+		/**
+		 *	Build the immutable table of parameters for common element counts and false positive rates
+		 * @return	True
+		 */
+		static bool Tabulate();
+
 		/**
-		 *	Calculate Filter Parameters based on Inputs
+		 *	Calculate Filter Parameters based on Inputs, consulting the parameter table first
 		 * @param numElements		Number of elements to be contained in the filter
 		 * @param falsePositiveRate	Maximum allowable false positive rate
 		 * @param tableSize[out]	Outputted table size in bytes
@@ -273,13 +597,233 @@ namespace Radicle { namespace SDRP
 							const RDDouble falsePositiveRate,
 							RDSize& tableSize,
 							RDSize& hashCount );
+
+		/**
+		 *	Derive Filter Parameters from the standard bloom filter sizing formulae
+		 * @param numElements		Number of elements to be contained in the filter
+		 * @param falsePositiveRate	Maximum allowable false positive rate
+		 * @param tableSize[out]	Outputted table size in bytes
+		 * @param hashCount[out]	Outputted number of hashes to use for insertions
+		 */
+		static void ComputeParameters( 	const RDSize numElements, 
+							const RDDouble falsePositiveRate,
+							RDSize& tableSize,
+							RDSize& hashCount );
 		
+		/**
+		 *	Derive the probed slots for a batch of identifiers and prefetch the table bytes holding them
+		 * @param ids		Identifiers
+		 * @param count		Number of identifiers, at most one batch
+		 * @param slots[out]	Probed slots, the slots of each identifier consecutive
+		 */
+		void BatchProbes( const RDIdentifier* ids, const RDSize count, RDSize* slots ) const;
+
 		/**
 		 *	Initialize the Bloom Filter with the provided parameters
 		 * @param tableSize	Size of the Data Table in Bytes
 		 * @param hasCount	Number of hashes to use on insertion
 		 */
 		void Initialize( const RDSize tableSize, const RDSize hashCount );
+
+		/**
+		 *	Allocate a heap table with a reference count of one
+		 * @param tableBytes	Table Size in Bytes
+		 */
+		void Allocate( const RDSize tableBytes );
+
+		/**
+		 *	Drop this filter's reference to its heap table, freeing the table if no other filter shares it
+		 */
+		void Release();
+
+		/**
+		 *	Get the size of the block holding a heap table and its reference count
+		 * @param tableBytes	Table Size in Bytes
+		 * @return		Block Size in Bytes
+		 */
+		static RDSize BlockBytes( const RDSize tableBytes );
+
+		/**
+		 *	Give this filter its own copy of a shared heap table prior to modification
+		 */
+		void Unshare();
+
+		/**
+		 *	Get the table size actually used for a requested size under the given layout and reduction
+		 * @param tableSize	Requested Table Size in Slots
+		 * @param layout	Table Layout
+		 * @param reduction	Index Reduction
+		 * @return		Table Size in Slots
+		 */
+		static RDSize AlignedTableSize( const RDSize tableSize, const TableLayout layout, const IndexReduction reduction );
+
+		/**
+		 *	Serialize a filter header. Compact headers hold a lead byte carrying the marker, version
+		 *	and a hash count nibble, a byte of format flags, the table size as a varint and, for hash
+		 *	counts which do not fit the nibble, the hash count as a varint.
+		 * @param buffer		Data buffer into which the header should be serialized
+		 * @param bufferSize		Size of the buffer in bytes
+		 * @param offset		Offset into the buffer at which serialization should begin
+		 * @param newOffset		New offset produced by serializing the header
+		 * @param tableSize		Table Size in Slots
+		 * @param serializedHashCount	Hash Count combined with its format flags
+		 * @return			True - If serialization was successful. False otherwise.
+		 */
+		static bool SerializeHeader( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset,
+						const RDSize tableSize,
+						const RDSize serializedHashCount );
+
+		/**
+		 *	Deserialize a compact or legacy filter header
+		 * @param buffer			Data buffer from which the header should be deserialized
+		 * @param bufferSize			Size of the buffer in bytes
+		 * @param offset			Offset into the buffer at which deserialization should begin
+		 * @param newOffset			New offset produced by deserializing the header
+		 * @param tableSize[out]		Table Size in Slots
+		 * @param serializedHashCount[out]	Hash Count combined with its format flags
+		 * @return				True - If deserialization was successful. False otherwise.
+		 */
+		static bool DeserializeHeader( 	const RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset,
+						RDSize& tableSize,
+						RDSize& serializedHashCount );
+
+		/**
+		 *	Get the number of bytes a compressed table of the specified size is coded from. Tables
+		 *	under eight slots are padded to eight bytes as raw tables are, while larger tables
+		 *	also carry any slots in a final partial byte, which raw tables drop.
+		 * @param tableSize	Table Size in Slots
+		 * @return		Packed Table Size in Bytes
+		 */
+		static RDSize PackedBytes( const RDSize tableSize );
+
+		/**
+		 *	Combine a hash count with the format flags describing a serialized table
+		 * @param hashCount	Hash Count
+		 * @param layout	Table Layout
+		 * @param hashing	Hashing Scheme
+		 * @param reduction	Index Reduction
+		 * @param encoding	Table Encoding
+		 * @return		Serialized Hash Count
+		 */
+		static RDSize EncodeFormat( 	const RDSize hashCount, 
+						const TableLayout layout, 
+						const HashScheme hashing, 
+						const IndexReduction reduction,
+						const FilterCodec::Encoding encoding );
+
+		/**
+		 *	Split a serialized hash count into the hash count and the format it carries
+		 * @param serializedHashCount	Serialized Hash Count
+		 * @param layout[out]		Table Layout
+		 * @param hashing[out]		Hashing Scheme
+		 * @param reduction[out]	Index Reduction
+		 * @param encoding[out]		Table Encoding
+		 * @return			Hash Count
+		 */
+		static RDSize DecodeFormat( 	const RDSize serializedHashCount, 
+						TableLayout& layout, 
+						HashScheme& hashing, 
+						IndexReduction& reduction,
+						FilterCodec::Encoding& encoding );
+
+		/**
+		 *	Reduce a hash to an index within the specified range
+		 * @param hash		Hash Value. Only the lower 32 bits are used by multiply-shift reduction.
+		 * @param range		Size of the Index Range. A power of two under mask reduction.
+		 * @param reduction	Index Reduction
+		 * @return		Index in the range [0, range)
+		 */
+		static RDSize Reduce( const RDSize hash, const RDSize range, const IndexReduction reduction );
+
+		/**
+		 *	Wrap a table index into the table
+		 * @param index	Table Index
+		 * @return	Slot Index
+		 */
+		RDSize Wrap( const RDSize index ) const;
+
+		/**
+		 *	Check that another filter may be folded to a common size with this filter
+		 * @param other	Other Bloom Filter
+		 */
+		void CheckFoldable( const BloomFilter& other ) const throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Check whether this filter may be folded to the specified size
+		 * @param tableSize	Table Size
+		 * @return		True - If folding preserves every probe. False otherwise.
+		 */
+		bool FoldsTo( const RDSize tableSize ) const;
+
+		/**
+		 *	Get the slot which a slot of this filter becomes once folded
+		 * @param slot		Slot Index
+		 * @param tableSize	Folded Table Size
+		 * @return		Folded Slot Index
+		 */
+		RDSize FoldSlot( const RDSize slot, const RDSize tableSize ) const;
+
+		/**
+		 *	Fold a copy of the larger of this filter and another to the size of the smaller
+		 * @param other		Other Bloom Filter
+		 * @param folded[out]	Folded Copy
+		 * @return		True - If this filter was the larger. False otherwise.
+		 */
+		bool FoldLarger( const BloomFilter& other, BloomFilter& folded ) const throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Estimate the number of distinct elements inserted into a filter from the number of
+		 *	slots set
+		 * @param population	Number of Slots Set
+		 * @param tableSize	Table Size in Slots
+		 * @param hashCount	Number of Hashes used for Insertions
+		 * @return		Estimated Element Count
+		 */
+		static RDDouble Cardinality( const RDSize population, const RDSize tableSize, const RDSize hashCount );
+
+		/**
+		 *	Get the number of bytes occupied by the data table
+		 * @return	Data Table Size in Bytes
+		 */
+		RDSize TableBytes() const;
+
+		/**
+		 *	Check whether this filter derives probes from identifiers in the same way as another
+		 * @param other	Other Bloom Filter
+		 * @return	True - If both filters share size, layout, hashing scheme and index reduction. 
+		 *		False otherwise.
+		 */
+		bool Compatible( const BloomFilter& other ) const;
+
+		/**
+		 *	Get the value held in the specified slot. Blocked filters hold either 0 or 1.
+		 * @param slot	Slot Index
+		 * @return	Slot Value
+		 */
+		RDUByte8 SlotValue( const RDSize slot ) const;
+
+		/**
+		 *	Increment the counter held in the specified slot, saturating at the counter maximum
+		 * @param slot	Slot Index
+		 */
+		void Increment( const RDSize slot );
+
+		/**
+		 *	Decrement the counter held in the specified slot unless it is empty or saturated
+		 * @param slot	Slot Index
+		 */
+		void Decrement( const RDSize slot );
+
+		/**
+		 *	Recount the set slots after the table has been modified in bulk
+		 */
+		void Recount();
 		
 		/**
 		 *	Check whether the bit at the specified index in the provided buffer is set
@@ -296,12 +840,32 @@ namespace Radicle { namespace SDRP
 		 */
 		void SetBit( RDUByte8* buffer, const RDSize bit ) const;
 			
-		/// Data Table
+		/// Data Table. Points at the inline storage when the table fits within it.
 		RDUByte8*	m_table;
+		/// Inline Table Storage
+		RDUByte8	m_inline[ RD_SDRP_BLOOM_FILTER_INLINE_BYTES ];
+		/// Reference Count of the Heap Allocated Table, which directly precedes the table. NULL when inline.
+		RDSize*		m_references;
+		/// Size of the Heap Allocated Table in Bytes
+		RDSize		m_capacity;
+		/// Allocator of the Heap Allocated Table
+		IAllocator*	m_allocator;
 		/// Size of the Bit Table in Bytes
 		RDSize		m_tableSize;	
 		/// Number of Hashes per Element
 		RDSize		m_hashCount;		
+		/// Number of Set Slots
+		RDSize		m_population;
+		/// Table Layout
+		TableLayout	m_layout;
+		/// Hashing Scheme
+		HashScheme	m_hashing;
+		/// Index Reduction
+		IndexReduction	m_reduction;
+		/// Digest of the Table, valid while m_digested is set
+		mutable RDSize	m_digest;
+		/// Whether m_digest describes the current Table
+		mutable bool	m_digested;
 	};
 } }
 
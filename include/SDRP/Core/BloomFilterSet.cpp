@@ -0,0 +1,76 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/BloomFilterSet.h>
+
+namespace Radicle { namespace SDRP
+{
+	BloomFilterSet::BloomFilterSet( const RDSize numElements, const RDDouble falsePositiveRate ) :
+	m_filter( numElements, falsePositiveRate, BloomFilter::Counting )
+	{}
+
+	bool BloomFilterSet::Insert( const RDIdentifier id )
+	{
+		m_filter.Insert( id );
+		return true;
+	}
+
+	bool BloomFilterSet::Remove( const RDIdentifier id )
+	{
+		if( m_filter.Contains( id ) )
+		{
+			m_filter.Remove( id );
+			return true;
+		}
+
+		return false;
+	}
+
+	bool BloomFilterSet::Contains( const RDIdentifier id ) const
+	{
+		return m_filter.Contains( id );
+	}
+
+	bool BloomFilterSet::HasElements() const
+	{
+		return m_filter.HasElements();
+	}
+
+	void BloomFilterSet::Clear()
+	{
+		m_filter.Clear();
+	}
+
+	const RDSize BloomFilterSet::Footprint() const
+	{
+		return m_filter.TableBytes();
+	}
+
+	const BloomFilter& BloomFilterSet::Filter() const
+	{
+		return m_filter;
+	}
+
+	bool BloomFilterSet::Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const
+	{
+		return m_filter.Serialize( buffer, bufferSize, offset, newOffset );
+	}
+
+	bool BloomFilterSet::Deserialize( 	const RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset )
+	{
+		return m_filter.Deserialize( buffer, bufferSize, offset, newOffset );
+	}
+} }
@@ -0,0 +1,112 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_BLOOM_FILTER_SET_H
+#define RD_SDRP_BLOOM_FILTER_SET_H
+
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/BloomFilter.h>
+#include <SDRP/Core/IIdentifierSet.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	Presents a counting bloom filter through the common identifier set interface
+	 */
+	class BloomFilterSet : public IIdentifierSet
+	{
+	public:
+
+		/**
+		 *	Default Constructor
+		 * @param numElements		Number of Elements to be Contained
+		 * @param falsePositiveRate	Maximum False Positive Rate
+		 */
+		BloomFilterSet( const RDSize numElements = BloomFilter::PredictedElementCount,
+				const RDDouble falsePositiveRate = BloomFilter::DesiredFalsePositiveRate );
+
+		/**
+		 *	Insert the provided identifier into the set
+		 * @param id	Identifier to be inserted
+		 * @return	True - Counting filters are never full
+		 */
+		virtual bool Insert( const RDIdentifier id );
+
+		/**
+		 *	Remove the provided identifier from the set
+		 * @param id	Identifier to be removed
+		 * @return	True - If the set contained the identifier. False otherwise.
+		 */
+		virtual bool Remove( const RDIdentifier id );
+
+		/**
+		 *	Check whether the set contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If the set contains the identifier. False otherwise.
+		 */
+		virtual bool Contains( const RDIdentifier id ) const;
+
+		/**
+		 *	Check whether the set contains any elements
+		 * @return	True - If the set contains any elements. False otherwise.
+		 */
+		virtual bool HasElements() const;
+
+		/**
+		 *	Clear all elements from the set
+		 */
+		virtual void Clear();
+
+		/**
+		 *	Get the memory held by the filter's table
+		 * @return	Table Size in Bytes
+		 */
+		virtual const RDSize Footprint() const;
+
+		/**
+		 *	Get the underlying bloom filter
+		 * @return	Bloom Filter
+		 */
+		const BloomFilter& Filter() const;
+
+		/**
+		 *	Serialize the underlying bloom filter into the provided data buffer
+		 * @param buffer	Data buffer into which the object should be serialized
+		 * @param bufferSize	Size of the data buffer in bytes
+		 * @param offset	Offset into the buffer at which serialization should begin
+		 * @param newOffset	New offset produced by serialization
+		 * @return		True - If serialization was successful. False otherwise.
+		 */
+		virtual bool Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const;
+
+		/**
+		 *	Deserialize the underlying bloom filter from the provided data buffer
+		 * @param buffer	Data buffer from which the object should be deserialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which deserialization should begin
+		 * @param newOffset	New offset produced by deserializing the object
+		 * @return		True - If deserialization was successful. False otherwise.
+		 */
+		virtual bool Deserialize( 	const RDUByte8* buffer,
+		 				const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset );
+
+	private:
+
+		/// Underlying Filter
+		BloomFilter	m_filter;
+	};
+} }
+
+#endif // RD_SDRP_BLOOM_FILTER_SET_H
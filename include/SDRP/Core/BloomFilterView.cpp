@@ -0,0 +1,187 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/BloomFilterView.h>
+#include <SDRP/Core/Macros.h>
+#include <SDRP/Utilities/FilterKernels.h>
+#include <SDRP/Utilities/FilterCodec.h>
+
+namespace Radicle { namespace SDRP
+{
+	BloomFilterView::BloomFilterView() :
+	m_buffer( NULL ),
+	m_bufferSize( 0 ),
+	m_offset( 0 ),
+	m_bits( NULL ),
+	m_bitBytes( 0 ),
+	m_tableSize( 0 ),
+	m_hashCount( 0 ),
+	m_layout( BloomFilter::Counting ),
+	m_hashing( BloomFilter::ChainedHashing ),
+	m_reduction( BloomFilter::ModuloReduction )
+	{}
+
+	bool BloomFilterView::Deserialize( 	const RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset )
+	{
+		RDSize tableSize, hashCount;
+		FilterCodec::Encoding encoding;
+
+		if( BloomFilter::DeserializeHeader( buffer, bufferSize, offset, newOffset, tableSize, hashCount ) )
+		{
+			hashCount = BloomFilter::DecodeFormat( hashCount, m_layout, m_hashing, m_reduction, encoding );
+
+			if( BloomFilter::AlignedTableSize( tableSize, m_layout, m_reduction ) != tableSize )
+			{
+				RD_PRINT( "Table Size " << tableSize << " does not match the Layout and Index Reduction" );
+				return false;
+			}
+
+			RDSize bitBytes = 0;
+
+			if( tableSize > 0 )
+			{
+				bitBytes = tableSize < BloomFilter::BitsPerChar ? BloomFilter::BitsPerChar : tableSize / BloomFilter::BitsPerChar;
+			}
+
+			if( encoding == FilterCodec::Raw || bitBytes == 0 )
+			{
+				if( bufferSize - newOffset < bitBytes || bitBytes * BloomFilter::BitsPerChar < tableSize )
+				{
+					RD_PRINT( "Failed to Deserialize Table Buffer" );
+					return false;
+				}
+
+				m_bits = buffer + newOffset;
+				m_decoded.clear();
+				newOffset += bitBytes;
+			}
+			else
+			{
+				bitBytes = BloomFilter::PackedBytes( tableSize );
+				m_decoded.resize( static_cast<size_t>( bitBytes ) );
+
+				if( FilterCodec::Decode( buffer, bufferSize, newOffset, newOffset, &m_decoded[ 0 ], bitBytes, encoding ) == false )
+				{
+					RD_PRINT( "Failed to Decode Table Buffer" );
+					return false;
+				}
+
+				m_bits = NULL;
+			}
+
+			m_buffer = buffer;
+			m_bufferSize = bufferSize;
+			m_offset = offset;
+			m_bitBytes = bitBytes;
+			m_tableSize = tableSize;
+			m_hashCount = hashCount;
+
+			return true;
+		}
+		else
+		{
+			RD_PRINT( "Failed to Deserialize Table Size and Hash Count" );
+		}
+
+		return false;
+	}
+
+	bool BloomFilterView::Contains( const RDIdentifier id ) const
+	{
+		if( m_tableSize > 0 )
+		{
+			BloomFilter::Probe probe( m_tableSize, m_layout, m_hashing, m_reduction, id );
+
+			for( RDUInt32 i = 0; i < m_hashCount; i++ )
+			{
+				if( Check( probe.Next() ) == false )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool BloomFilterView::Contains( const BloomFilterView& other ) const
+	{
+		if( m_tableSize > 0 && Compatible( other ) )
+		{
+			return FilterKernels::BitCovers( Bits(), other.Bits(), m_bitBytes );
+		}
+
+		return false;
+	}
+
+	bool BloomFilterView::HasElements() const
+	{
+		return FilterKernels::Any( Bits(), m_bitBytes );
+	}
+
+	const RDSize BloomFilterView::SetBytes() const
+	{
+		return FilterKernels::BitPopulation( Bits(), m_bitBytes );
+	}
+
+	RDSize BloomFilterView::Difference( const BloomFilterView& other ) const throw( BloomFilterSizeMismatchException )
+	{
+		if( Compatible( other ) == false )
+		{
+			throw BloomFilterSizeMismatchException();
+		}
+
+		return FilterKernels::BitDifference( Bits(), other.Bits(), m_bitBytes );
+	}
+
+	bool BloomFilterView::Materialize( BloomFilter& filter ) const
+	{
+		RDSize newOffset;
+
+		if( m_buffer == NULL )
+		{
+			filter = BloomFilter::Empty;
+			return true;
+		}
+
+		return filter.Deserialize( m_buffer, m_bufferSize, m_offset, newOffset );
+	}
+
+	const RDSize BloomFilterView::TableSize() const
+	{
+		return m_tableSize;
+	}
+
+	const RDSize BloomFilterView::HashCount() const
+	{
+		return m_hashCount;
+	}
+
+	bool BloomFilterView::Compatible( const BloomFilterView& other ) const
+	{
+		return 	m_tableSize == other.m_tableSize && m_layout == other.m_layout &&
+			m_hashing == other.m_hashing && m_reduction == other.m_reduction;
+	}
+
+	const RDUByte8* BloomFilterView::Bits() const
+	{
+		return m_decoded.empty() ? m_bits : &m_decoded[ 0 ];
+	}
+
+	bool BloomFilterView::Check( const RDSize slot ) const
+	{
+		return ( Bits()[ slot / BloomFilter::BitsPerChar ] >> ( slot % BloomFilter::BitsPerChar ) ) & 0x01;
+	}
+} }
@@ -0,0 +1,147 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_BLOOM_FILTER_VIEW_H
+#define RD_SDRP_BLOOM_FILTER_VIEW_H
+
+#include <vector>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/BloomFilter.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	A read-only view of a serialized bloom filter. Queries on raw tables are answered directly 
+	 *	against the packed bits in the buffer the view was attached to, which must outlive the view.
+	 *	Compressed tables are decoded into storage held by the view.
+	 */
+	class BloomFilterView
+	{
+	public:
+
+		/**
+		 *	Default Constructor. Creates an empty view.
+		 */
+		BloomFilterView();
+
+		/**
+		 *	Attach the view to the filter serialized in the provided buffer without copying it
+		 * @param buffer	Data buffer holding the serialized filter
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which the filter begins
+		 * @param newOffset	Offset of the first byte following the filter
+		 * @return		True - If the buffer holds a complete filter. False otherwise.
+		 */
+		bool Deserialize( 	const RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset );
+
+		/**
+		 *	Check whether the viewed filter contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If the filter contains the identifier. False otherwise.
+		 */
+		bool Contains( const RDIdentifier id ) const;
+
+		/**
+		 *	Check whether the viewed filter contains all of the elements in another viewed filter
+		 * @param other	Other View
+		 * @return	True - If this filter contains all of the elements in \a other. False otherwise.
+		 */
+		bool Contains( const BloomFilterView& other ) const;
+
+		/**
+		 *	Check whether the viewed filter contains any elements
+		 * @return	True - If the filter contains any elements. False otherwise.
+		 */
+		bool HasElements() const;
+
+		/**
+		 *	Get the number of slots set in the viewed filter
+		 * @return	Number of set slots
+		 */
+		const RDSize SetBytes() const;
+
+		/**
+		 *	Get the degree of difference between this viewed filter and another
+		 * @param other	Other View
+		 * @return	Number of slots differently set between this filter and \a other
+		 */
+		RDSize Difference( const BloomFilterView& other ) const throw( BloomFilterSizeMismatchException );
+
+		/**
+		 *	Deserialize the viewed filter into a bloom filter
+		 * @param filter	Filter to be filled
+		 * @return		True - If the filter was deserialized. False otherwise.
+		 */
+		bool Materialize( BloomFilter& filter ) const;
+
+		/**
+		 *	Get the size of the viewed filter in slots
+		 * @return	Table Size
+		 */
+		const RDSize TableSize() const;
+
+		/**
+		 *	Get the number of hashes used for insertions into the viewed filter
+		 * @return	Hash Count
+		 */
+		const RDSize HashCount() const;
+
+	private:
+
+		/**
+		 *	Check whether another view derives probes from identifiers in the same way as this one
+		 * @param other	Other View
+		 * @return	True - If both views share size, layout, hashing scheme and index reduction.
+		 *		False otherwise.
+		 */
+		bool Compatible( const BloomFilterView& other ) const;
+
+		/**
+		 *	Get the packed slot bits of the viewed filter
+		 * @return	Packed Slot Bits
+		 */
+		const RDUByte8* Bits() const;
+
+		/**
+		 *	Check whether the specified slot is set
+		 * @param slot	Slot Index
+		 * @return	True - If the slot is set. False otherwise.
+		 */
+		bool Check( const RDSize slot ) const;
+
+		/// Buffer holding the Serialized Filter
+		const RDUByte8*			m_buffer;
+		/// Size of the Buffer in Bytes
+		RDSize				m_bufferSize;
+		/// Offset of the Serialized Filter within the Buffer
+		RDSize				m_offset;
+		/// Packed Slot Bits within the Buffer. NULL for compressed tables.
+		const RDUByte8*			m_bits;
+		/// Packed Slot Bits decoded from a compressed table
+		std::vector<RDUByte8>		m_decoded;
+		/// Number of Packed Bytes
+		RDSize				m_bitBytes;
+		/// Size of the Table in Slots
+		RDSize				m_tableSize;
+		/// Number of Hashes per Element
+		RDSize				m_hashCount;
+		/// Table Layout
+		BloomFilter::TableLayout	m_layout;
+		/// Hashing Scheme
+		BloomFilter::HashScheme		m_hashing;
+		/// Index Reduction
+		BloomFilter::IndexReduction	m_reduction;
+	};
+} }
+
+#endif // RD_SDRP_BLOOM_FILTER_VIEW_H
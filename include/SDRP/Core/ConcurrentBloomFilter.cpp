@@ -0,0 +1,234 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/ConcurrentBloomFilter.h>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace Radicle { namespace SDRP
+{
+	namespace
+	{
+		/**
+		 *	Load a table word with relaxed ordering
+		 */
+		inline RDUInt32 AtomicLoad( const volatile RDUInt32* word )
+		{
+#if defined( __GNUC__ )
+			return __atomic_load_n( word, __ATOMIC_RELAXED );
+#else
+			// Aligned 32-bit reads are atomic on all supported platforms
+			return *word;
+#endif
+		}
+
+		/**
+		 *	Store a table word with relaxed ordering
+		 */
+		inline void AtomicStore( volatile RDUInt32* word, const RDUInt32 value )
+		{
+#if defined( __GNUC__ )
+			__atomic_store_n( word, value, __ATOMIC_RELAXED );
+#else
+			*word = value;
+#endif
+		}
+
+		/**
+		 *	Replace a table word with \a desired if it still holds \a expected
+		 * @return	True - If the word was replaced. False otherwise.
+		 */
+		inline bool AtomicCompareExchange( volatile RDUInt32* word, RDUInt32 expected, const RDUInt32 desired )
+		{
+#if defined( __GNUC__ )
+			return __atomic_compare_exchange_n( word, &expected, desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED );
+#else
+			return 	static_cast<RDUInt32>( _InterlockedCompareExchange( 	reinterpret_cast<volatile long*>( word ),
+											static_cast<long>( desired ),
+											static_cast<long>( expected ) ) ) == expected;
+#endif
+		}
+	}
+
+	const RDSize ConcurrentBloomFilter::CountersPerWord = 8;
+
+	ConcurrentBloomFilter::ConcurrentBloomFilter( 	const RDSize numElements,
+							const RDDouble falsePositiveRate ) :
+	m_table( NULL ),
+	m_words( 0 ),
+	m_tableSize( 0 ),
+	m_hashCount( 0 ),
+	m_hashing( BloomFilter::DefaultHashScheme ),
+	m_reduction( BloomFilter::DefaultReduction )
+	{
+		Initialize( BloomFilter( numElements, falsePositiveRate, BloomFilter::Counting ) );
+	}
+
+	ConcurrentBloomFilter::ConcurrentBloomFilter( const BloomFilter& filter ) :
+	m_table( NULL ),
+	m_words( 0 ),
+	m_tableSize( 0 ),
+	m_hashCount( 0 ),
+	m_hashing( filter.m_hashing ),
+	m_reduction( filter.m_reduction )
+	{
+		Initialize( filter );
+	}
+
+	void ConcurrentBloomFilter::Insert( const RDIdentifier id )
+	{
+		if( m_tableSize > 0 )
+		{
+			BloomFilter::Probe probe( m_tableSize, BloomFilter::Counting, m_hashing, m_reduction, id );
+
+			for( RDUInt32 i = 0; i < m_hashCount; i++ )
+			{
+				Update( probe.Next(), true );
+			}
+		}
+	}
+
+	bool ConcurrentBloomFilter::Contains( const RDIdentifier id ) const
+	{
+		if( m_tableSize > 0 )
+		{
+			BloomFilter::Probe probe( m_tableSize, BloomFilter::Counting, m_hashing, m_reduction, id );
+
+			for( RDUInt32 i = 0; i < m_hashCount; i++ )
+			{
+				if( SlotValue( probe.Next() ) == 0 )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void ConcurrentBloomFilter::Remove( const RDIdentifier id )
+	{
+		if( Contains( id ) )
+		{
+			BloomFilter::Probe probe( m_tableSize, BloomFilter::Counting, m_hashing, m_reduction, id );
+
+			for( RDUInt32 i = 0; i < m_hashCount; i++ )
+			{
+				Update( probe.Next(), false );
+			}
+		}
+	}
+
+	void ConcurrentBloomFilter::Clear()
+	{
+		for( RDSize i = 0; i < m_words; i++ )
+		{
+			AtomicStore( m_table + i, 0 );
+		}
+	}
+
+	void ConcurrentBloomFilter::Snapshot( BloomFilter& filter ) const
+	{
+		filter.m_layout = BloomFilter::Counting;
+		filter.m_hashing = m_hashing;
+		filter.m_reduction = m_reduction;
+		filter.Initialize( m_tableSize, m_hashCount );
+
+		RDSize tableBytes = filter.TableBytes();
+
+		for( RDSize i = 0; i < m_words; i++ )
+		{
+			RDUInt32 word = AtomicLoad( m_table + i );
+
+			// Both tables hold the even slot of each byte in its low nibble
+			for( RDSize j = 0; j < sizeof( RDUInt32 ) && i * sizeof( RDUInt32 ) + j < tableBytes; j++ )
+			{
+				filter.m_table[ i * sizeof( RDUInt32 ) + j ] = static_cast<RDUByte8>( word >> ( j * 8 ) );
+			}
+		}
+
+		filter.Recount();
+	}
+
+	const RDSize ConcurrentBloomFilter::TableSize() const
+	{
+		return m_tableSize;
+	}
+
+	const RDSize ConcurrentBloomFilter::HashCount() const
+	{
+		return m_hashCount;
+	}
+
+	ConcurrentBloomFilter::~ConcurrentBloomFilter()
+	{
+		if( m_table != NULL )
+		{
+			delete[] m_table;
+		}
+	}
+
+	void ConcurrentBloomFilter::Initialize( const BloomFilter& filter )
+	{
+		m_tableSize = BloomFilter::AlignedTableSize( filter.m_tableSize, BloomFilter::Counting, m_reduction );
+		m_hashCount = filter.m_hashCount;
+		m_words = ( m_tableSize + CountersPerWord - 1 ) / CountersPerWord;
+
+		if( m_words > 0 )
+		{
+			m_table = new RDUInt32[ static_cast<RDUInt32>( m_words ) ];
+			Clear();
+		}
+
+		// Blocked filters probe differently, so only counting filter contents carry over
+		if( filter.m_layout == BloomFilter::Counting && filter.m_tableSize == m_tableSize )
+		{
+			for( RDSize slot = 0; slot < m_tableSize; slot++ )
+			{
+				for( RDUByte8 count = filter.SlotValue( slot ); count > 0; count-- )
+				{
+					Update( slot, true );
+				}
+			}
+		}
+	}
+
+	RDUByte8 ConcurrentBloomFilter::SlotValue( const RDSize slot ) const
+	{
+		RDUInt32 word = AtomicLoad( m_table + slot / CountersPerWord );
+		return static_cast<RDUByte8>( ( word >> ( ( slot % CountersPerWord ) * 4 ) ) & 0x0F );
+	}
+
+	void ConcurrentBloomFilter::Update( const RDSize slot, const bool increment )
+	{
+		volatile RDUInt32* word = m_table + slot / CountersPerWord;
+		RDUInt32 shift = static_cast<RDUInt32>( ( slot % CountersPerWord ) * 4 );
+		RDUInt32 expected, desired;
+
+		do
+		{
+			expected = AtomicLoad( word );
+			RDUInt32 count = ( expected >> shift ) & 0x0F;
+
+			// Saturated counters no longer know their true count and are left alone
+			if( count == 0x0F || ( increment == false && count == 0 ) )
+			{
+				return;
+			}
+
+			desired = increment ? expected + ( 1u << shift ) : expected - ( 1u << shift );
+		}
+		while( AtomicCompareExchange( word, expected, desired ) == false );
+	}
+} }
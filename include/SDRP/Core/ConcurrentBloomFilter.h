@@ -0,0 +1,137 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_CONCURRENT_BLOOM_FILTER_H
+#define RD_SDRP_CONCURRENT_BLOOM_FILTER_H
+
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/BloomFilter.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	A counting bloom filter which may be inserted into, removed from and queried by several
+	 *	threads at once. Counters are updated with relaxed atomic compare-and-swap operations and
+	 *	lookups take no locks. Plain bloom filter snapshots are used for serialization and set algebra.
+	 */
+	class ConcurrentBloomFilter
+	{
+	public:
+
+		/**
+		 *	Default Constructor
+		 * @param numElements		Number of Elements to be Contained
+		 * @param falsePositiveRate	Maximum False Positive Rate
+		 */
+		ConcurrentBloomFilter( 	const RDSize numElements = BloomFilter::PredictedElementCount,
+					const RDDouble falsePositiveRate = BloomFilter::DesiredFalsePositiveRate );
+
+		/**
+		 *	Initializing Constructor. Takes the parameters and contents of a plain bloom filter.
+		 *	Blocked filters contribute a count of one for each set slot.
+		 * @param filter	Bloom Filter
+		 */
+		explicit ConcurrentBloomFilter( const BloomFilter& filter );
+
+		/**
+		 *	Insert the provided identifier into the filter
+		 * @param id	Identifier to be inserted
+		 */
+		void Insert( const RDIdentifier id );
+
+		/**
+		 *	Check whether the filter contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If the filter contains the identifier. False otherwise.
+		 */
+		bool Contains( const RDIdentifier id ) const;
+
+		/**
+		 *	Remove the provided identifier from the filter if it is contained
+		 * @param id	Identifier to be removed
+		 */
+		void Remove( const RDIdentifier id );
+
+		/**
+		 *	Clear all elements from the filter. Insertions made during the clear may be lost.
+		 */
+		void Clear();
+
+		/**
+		 *	Copy the current contents of the filter into a plain counting bloom filter. Each counter
+		 *	is read atomically, but updates made during the copy may be only partially reflected.
+		 * @param filter	Filter to be filled
+		 */
+		void Snapshot( BloomFilter& filter ) const;
+
+		/**
+		 *	Get the size of the filter in slots
+		 * @return	Table Size
+		 */
+		const RDSize TableSize() const;
+
+		/**
+		 *	Get the number of hashes used for filter insertions
+		 * @return	Hash Count
+		 */
+		const RDSize HashCount() const;
+
+		/**
+		 *	Default Destructor
+		 */
+		~ConcurrentBloomFilter();
+
+	private:
+
+		/// Number of 4-bit Counters in each Table Word
+		const static RDSize		CountersPerWord;
+
+		/**
+		 *	Copying is not supported
+		 */
+		ConcurrentBloomFilter( const ConcurrentBloomFilter& other );
+		ConcurrentBloomFilter& operator=( const ConcurrentBloomFilter& other );
+
+		/**
+		 *	Initialize the filter with the parameters of a plain bloom filter
+		 * @param filter	Bloom Filter
+		 */
+		void Initialize( const BloomFilter& filter );
+
+		/**
+		 *	Get the value held in the specified slot
+		 * @param slot	Slot Index
+		 * @return	Counter Value
+		 */
+		RDUByte8 SlotValue( const RDSize slot ) const;
+
+		/**
+		 *	Atomically add to the counter held in the specified slot, leaving saturated counters unchanged
+		 * @param slot		Slot Index
+		 * @param increment	True to increment the counter, false to decrement it
+		 */
+		void Update( const RDSize slot, const bool increment );
+
+		/// Counter Table
+		volatile RDUInt32*		m_table;
+		/// Number of Words in the Counter Table
+		RDSize				m_words;
+		/// Size of the Table in Slots
+		RDSize				m_tableSize;
+		/// Number of Hashes per Element
+		RDSize				m_hashCount;
+		/// Hashing Scheme
+		BloomFilter::HashScheme		m_hashing;
+		/// Index Reduction
+		BloomFilter::IndexReduction	m_reduction;
+	};
+} }
+
+#endif // RD_SDRP_CONCURRENT_BLOOM_FILTER_H
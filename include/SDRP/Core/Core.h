@@ -30,6 +30,19 @@
 #include <SDRP/Core/ErrorCodes.h>
 #include <SDRP/Core/Definitions.h>
 #include <SDRP/Core/BloomFilter.h>
+#include <SDRP/Core/BloomFilterView.h>
+#include <SDRP/Core/ConcurrentBloomFilter.h>
+#include <SDRP/Core/FixedBloomFilter.h>
+#include <SDRP/Core/MinHashSketch.h>
+#include <SDRP/Core/ScalableBloomFilter.h>
+#include <SDRP/Core/AttenuatedBloomFilter.h>
+#include <SDRP/Core/IIdentifierSet.h>
+#include <SDRP/Core/CuckooFilter.h>
+#include <SDRP/Core/BloomFilterSet.h>
+#include <SDRP/Core/IdentifierSetFactory.h>
+#include <SDRP/Core/IAllocator.h>
+#include <SDRP/Core/PoolAllocator.h>
+#include <SDRP/Core/ScratchArena.h>
 #include <SDRP/Core/ISerializable.h>
 
 // Utilities
@@ -0,0 +1,339 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/CuckooFilter.h>
+#include <SDRP/Core/Macros.h>
+#include <SDRP/Utilities/MurmurHash.h>
+#include <SDRP/Utilities/Serializer.h>
+#include <cmath>
+
+namespace Radicle { namespace SDRP
+{
+	const RDSize	CuckooFilter::BucketSlots		= 4;
+	const RDSize	CuckooFilter::MaximumKicks		= 500;
+	const RDDouble	CuckooFilter::LoadFactor		= 0.9;
+	const RDSize	CuckooFilter::MinimumFingerprintBits	= 4;
+	const RDSize	CuckooFilter::MaximumFingerprintBits	= 16;
+
+	namespace
+	{
+		/// Most buckets accepted when deserializing a filter. Identifiers are 16-bit, so no
+		/// larger table is ever useful.
+		const RDSize MaximumBuckets = 65536;
+	}
+
+	CuckooFilter::CuckooFilter( const RDSize numElements, const RDDouble falsePositiveRate )
+	{
+		// A lookup compares against two buckets' worth of fingerprints, each matching by chance
+		// with probability 2^-f
+		RDDouble rate = falsePositiveRate > 0.0 && falsePositiveRate < 1.0 ? falsePositiveRate : BloomFilter::DesiredFalsePositiveRate;
+		RDSize fingerprintBits = static_cast<RDSize>( std::ceil( std::log( 2.0 * BucketSlots / rate ) / std::log( 2.0 ) ) );
+
+		fingerprintBits = fingerprintBits < MinimumFingerprintBits ? MinimumFingerprintBits : fingerprintBits;
+		fingerprintBits = fingerprintBits > MaximumFingerprintBits ? MaximumFingerprintBits : fingerprintBits;
+
+		RDSize required = static_cast<RDSize>( std::ceil( numElements / ( BucketSlots * LoadFactor ) ) );
+		RDSize bucketCount = 1;
+
+		while( bucketCount < required && bucketCount < MaximumBuckets )
+		{
+			bucketCount <<= 1;
+		}
+
+		Initialize( bucketCount, fingerprintBits );
+	}
+
+	bool CuckooFilter::Insert( const RDIdentifier id )
+	{
+		if( m_hasVictim )
+		{
+			return false;
+		}
+
+		RDUInt16 fingerprint;
+		RDSize bucket = Locate( id, fingerprint );
+
+		if( Place( bucket, fingerprint ) == false && Place( Alternate( bucket, fingerprint ), fingerprint ) == false )
+		{
+			Relocate( bucket, fingerprint );
+		}
+
+		m_count++;
+		return true;
+	}
+
+	bool CuckooFilter::Remove( const RDIdentifier id )
+	{
+		RDUInt16 fingerprint;
+		RDSize bucket = Locate( id, fingerprint );
+		RDSize alternate = Alternate( bucket, fingerprint );
+
+		if( 	m_hasVictim && m_victim == fingerprint &&
+			( m_victimBucket == bucket || m_victimBucket == alternate ) )
+		{
+			m_hasVictim = false;
+			m_count--;
+			return true;
+		}
+
+		if( Erase( bucket, fingerprint ) || Erase( alternate, fingerprint ) )
+		{
+			m_count--;
+
+			// The freed slot may make room for a fingerprint held aside
+			if( m_hasVictim )
+			{
+				m_hasVictim = false;
+				Relocate( m_victimBucket, m_victim );
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool CuckooFilter::Contains( const RDIdentifier id ) const
+	{
+		RDUInt16 fingerprint;
+		RDSize bucket = Locate( id, fingerprint );
+		RDSize alternate = Alternate( bucket, fingerprint );
+
+		if( 	m_hasVictim && m_victim == fingerprint &&
+			( m_victimBucket == bucket || m_victimBucket == alternate ) )
+		{
+			return true;
+		}
+
+		return Holds( bucket, fingerprint ) || Holds( alternate, fingerprint );
+	}
+
+	bool CuckooFilter::HasElements() const
+	{
+		return m_count > 0;
+	}
+
+	void CuckooFilter::Clear()
+	{
+		Initialize( m_bucketCount, m_fingerprintBits );
+	}
+
+	const RDSize CuckooFilter::Footprint() const
+	{
+		return m_table.size();
+	}
+
+	const RDSize CuckooFilter::ElementCount() const
+	{
+		return m_count;
+	}
+
+	const RDSize CuckooFilter::BucketCount() const
+	{
+		return m_bucketCount;
+	}
+
+	const RDSize CuckooFilter::FingerprintBits() const
+	{
+		return m_fingerprintBits;
+	}
+
+	bool CuckooFilter::Serialize( 	RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset ) const
+	{
+		if( 	Serializer::SerializeVarint( buffer, bufferSize, offset, newOffset, m_bucketCount ) &&
+			Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_fingerprintBits ) &&
+			Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_count ) &&
+			Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_hasVictim ? m_victim : 0 ) )
+		{
+			if( m_hasVictim && Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_victimBucket ) == false )
+			{
+				return false;
+			}
+
+			return Serializer::BufferPack( buffer, bufferSize, newOffset, newOffset, &m_table[ 0 ], m_table.size() );
+		}
+
+		return false;
+	}
+
+	bool CuckooFilter::Deserialize( const RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset )
+	{
+		RDSize bucketCount, fingerprintBits, count, victim, victimBucket = 0;
+
+		if( 	Serializer::DeserializeVarint( buffer, bufferSize, offset, newOffset, bucketCount ) &&
+			Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, fingerprintBits ) &&
+			Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, count ) &&
+			Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, victim ) )
+		{
+			if( 	bucketCount == 0 || bucketCount > MaximumBuckets || ( bucketCount & ( bucketCount - 1 ) ) != 0 ||
+				fingerprintBits < MinimumFingerprintBits || fingerprintBits > MaximumFingerprintBits ||
+				victim >> fingerprintBits != 0 )
+			{
+				RD_PRINT( "Serialized Cuckoo Filter Geometry is out of range" );
+				return false;
+			}
+
+			if( victim != 0 && ( Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, victimBucket ) == false || victimBucket >= bucketCount ) )
+			{
+				RD_PRINT( "Failed to Deserialize Cuckoo Filter Victim" );
+				return false;
+			}
+
+			Initialize( bucketCount, fingerprintBits );
+
+			if( Serializer::BufferUnpack( buffer, bufferSize, newOffset, newOffset, &m_table[ 0 ], m_table.size() ) )
+			{
+				m_count = count;
+				m_hasVictim = victim != 0;
+				m_victim = static_cast<RDUInt16>( victim );
+				m_victimBucket = victimBucket;
+				return true;
+			}
+
+			RD_PRINT( "Failed to Deserialize Cuckoo Filter Table" );
+			Clear();
+		}
+		else
+		{
+			RD_PRINT( "Failed to Deserialize Cuckoo Filter Header" );
+		}
+
+		return false;
+	}
+
+	void CuckooFilter::Initialize( const RDSize bucketCount, const RDSize fingerprintBits )
+	{
+		m_bucketCount = bucketCount;
+		m_fingerprintBits = fingerprintBits;
+		m_count = 0;
+		m_hasVictim = false;
+		m_victimBucket = 0;
+		m_victim = 0;
+
+		m_table.assign( ( bucketCount * BucketSlots * fingerprintBits + 7 ) / 8, 0x00 );
+	}
+
+	RDSize CuckooFilter::Locate( const RDIdentifier id, RDUInt16& fingerprint ) const
+	{
+		RDUInt32 hash = MurmurHash::Hash( id, 0 );
+
+		// Fingerprints come from the high half of the hash and buckets from the low, so the two are independent
+		fingerprint = static_cast<RDUInt16>( ( hash >> 16 ) & ( ( 1u << m_fingerprintBits ) - 1 ) );
+		fingerprint = fingerprint == 0 ? 1 : fingerprint;
+
+		return hash & ( m_bucketCount - 1 );
+	}
+
+	RDSize CuckooFilter::Alternate( const RDSize bucket, const RDUInt16 fingerprint ) const
+	{
+		return ( bucket ^ MurmurHash::Hash( fingerprint, 0 ) ) & ( m_bucketCount - 1 );
+	}
+
+	void CuckooFilter::Relocate( RDSize bucket, RDUInt16 fingerprint )
+	{
+		for( RDSize kick = 0; kick < MaximumKicks; kick++ )
+		{
+			if( Place( bucket, fingerprint ) )
+			{
+				return;
+			}
+
+			// Evict a pseudo-randomly chosen occupant and carry it to its other bucket
+			RDSize slot = bucket * BucketSlots + MurmurHash::Hash( fingerprint, static_cast<RDUInt32>( kick ) ) % BucketSlots;
+			RDUInt16 evicted = Slot( slot );
+
+			Slot( slot, fingerprint );
+			fingerprint = evicted;
+			bucket = Alternate( bucket, fingerprint );
+		}
+
+		if( Place( bucket, fingerprint ) == false )
+		{
+			m_hasVictim = true;
+			m_victimBucket = bucket;
+			m_victim = fingerprint;
+		}
+	}
+
+	bool CuckooFilter::Place( const RDSize bucket, const RDUInt16 fingerprint )
+	{
+		for( RDSize slot = bucket * BucketSlots; slot < ( bucket + 1 ) * BucketSlots; slot++ )
+		{
+			if( Slot( slot ) == 0 )
+			{
+				Slot( slot, fingerprint );
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool CuckooFilter::Erase( const RDSize bucket, const RDUInt16 fingerprint )
+	{
+		for( RDSize slot = bucket * BucketSlots; slot < ( bucket + 1 ) * BucketSlots; slot++ )
+		{
+			if( Slot( slot ) == fingerprint )
+			{
+				Slot( slot, 0 );
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool CuckooFilter::Holds( const RDSize bucket, const RDUInt16 fingerprint ) const
+	{
+		for( RDSize slot = bucket * BucketSlots; slot < ( bucket + 1 ) * BucketSlots; slot++ )
+		{
+			if( Slot( slot ) == fingerprint )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	RDUInt16 CuckooFilter::Slot( const RDSize slot ) const
+	{
+		// A fingerprint of up to 16 bits spans at most three bytes
+		RDSize bit = slot * m_fingerprintBits;
+		RDSize byte = bit / 8;
+		RDUInt32 word = 0;
+
+		for( RDSize i = 0; i < 3 && byte + i < m_table.size(); i++ )
+		{
+			word |= static_cast<RDUInt32>( m_table[ byte + i ] ) << ( 8 * i );
+		}
+
+		return static_cast<RDUInt16>( ( word >> ( bit % 8 ) ) & ( ( 1u << m_fingerprintBits ) - 1 ) );
+	}
+
+	void CuckooFilter::Slot( const RDSize slot, const RDUInt16 fingerprint )
+	{
+		RDSize bit = slot * m_fingerprintBits;
+		RDSize byte = bit / 8;
+		RDUInt32 mask = ( ( 1u << m_fingerprintBits ) - 1 ) << ( bit % 8 );
+		RDUInt32 value = static_cast<RDUInt32>( fingerprint ) << ( bit % 8 );
+
+		for( RDSize i = 0; i < 3 && byte + i < m_table.size(); i++ )
+		{
+			m_table[ byte + i ] = static_cast<RDUByte8>( ( m_table[ byte + i ] & ~( mask >> ( 8 * i ) ) ) | ( ( value & mask ) >> ( 8 * i ) ) );
+		}
+	}
+} }
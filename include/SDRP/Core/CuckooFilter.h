@@ -0,0 +1,224 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_CUCKOO_FILTER_H
+#define RD_SDRP_CUCKOO_FILTER_H
+
+#include <vector>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/BloomFilter.h>
+#include <SDRP/Core/IIdentifierSet.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	A cuckoo filter. Each identifier is stored as a short fingerprint in one of two candidate
+	 *	buckets, the second found from the first and the fingerprint alone, such that fingerprints
+	 *	may be relocated without the identifiers they came from. Fingerprints are bit-packed, so
+	 *	the table holds roughly one fingerprint's width per element, against a byte per slot for
+	 *	a counting bloom filter of the same false positive rate.
+	 */
+	class CuckooFilter : public IIdentifierSet
+	{
+	public:
+
+		/// Number of fingerprints held by each bucket
+		const static RDSize	BucketSlots;
+		/// Most fingerprints relocated by a single insertion before the filter is considered full
+		const static RDSize	MaximumKicks;
+		/// Fraction of slots expected to be filled when holding the predicted number of elements
+		const static RDDouble	LoadFactor;
+		/// Narrowest Fingerprint in Bits
+		const static RDSize	MinimumFingerprintBits;
+		/// Widest Fingerprint in Bits
+		const static RDSize	MaximumFingerprintBits;
+
+		/**
+		 *	Default Constructor
+		 * @param numElements		Number of Elements to be Contained
+		 * @param falsePositiveRate	Maximum False Positive Rate
+		 */
+		CuckooFilter( 	const RDSize numElements = BloomFilter::PredictedElementCount,
+				const RDDouble falsePositiveRate = BloomFilter::DesiredFalsePositiveRate );
+
+		/**
+		 *	Insert the provided identifier into the filter. An identifier may be inserted more than
+		 *	once, and must then be removed as many times.
+		 * @param id	Identifier to be inserted
+		 * @return	True - If the identifier was inserted. False if the filter is full.
+		 */
+		virtual bool Insert( const RDIdentifier id );
+
+		/**
+		 *	Remove the provided identifier from the filter
+		 * @param id	Identifier to be removed
+		 * @return	True - If a matching fingerprint was found and removed. False otherwise.
+		 */
+		virtual bool Remove( const RDIdentifier id );
+
+		/**
+		 *	Check whether the filter contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If the filter contains the identifier. False otherwise.
+		 */
+		virtual bool Contains( const RDIdentifier id ) const;
+
+		/**
+		 *	Check whether the filter contains any elements
+		 * @return	True - If the filter contains any elements. False otherwise.
+		 */
+		virtual bool HasElements() const;
+
+		/**
+		 *	Clear all elements from the filter
+		 */
+		virtual void Clear();
+
+		/**
+		 *	Get the memory held by the filter's table
+		 * @return	Table Size in Bytes
+		 */
+		virtual const RDSize Footprint() const;
+
+		/**
+		 *	Get the number of elements held by the filter
+		 * @return	Element Count
+		 */
+		const RDSize ElementCount() const;
+
+		/**
+		 *	Get the number of buckets in the filter
+		 * @return	Bucket Count
+		 */
+		const RDSize BucketCount() const;
+
+		/**
+		 *	Get the width of each fingerprint
+		 * @return	Fingerprint Size in Bits
+		 */
+		const RDSize FingerprintBits() const;
+
+		/**
+		 *	Serialize this filter into the provided data buffer. The bucket count, fingerprint
+		 *	width, element count and any displaced fingerprint are written as varints, followed by
+		 *	the packed table.
+		 * @param buffer	Data buffer into which the object should be serialized
+		 * @param bufferSize	Size of the data buffer in bytes
+		 * @param offset	Offset into the buffer at which serialization should begin
+		 * @param newOffset	New offset produced by serialization
+		 * @return		True - If serialization was successful. False otherwise.
+		 */
+		virtual bool Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const;
+
+		/**
+		 *	Deserialize this filter from the provided data buffer
+		 * @param buffer	Data buffer from which the object should be deserialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which deserialization should begin
+		 * @param newOffset	New offset produced by deserializing the object
+		 * @return		True - If deserialization was successful. False otherwise.
+		 */
+		virtual bool Deserialize( 	const RDUByte8* buffer,
+		 				const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset );
+
+	private:
+
+		/**
+		 *	Size the table and clear it
+		 * @param bucketCount		Number of Buckets, a power of two
+		 * @param fingerprintBits	Fingerprint Size in Bits
+		 */
+		void Initialize( const RDSize bucketCount, const RDSize fingerprintBits );
+
+		/**
+		 *	Find the fingerprint and first candidate bucket of an identifier
+		 * @param id		Identifier
+		 * @param fingerprint	Non-zero Fingerprint
+		 * @return		Bucket Index
+		 */
+		RDSize Locate( const RDIdentifier id, RDUInt16& fingerprint ) const;
+
+		/**
+		 *	Find the other candidate bucket of a fingerprint
+		 * @param bucket	Either Candidate Bucket
+		 * @param fingerprint	Fingerprint
+		 * @return		The Other Candidate Bucket
+		 */
+		RDSize Alternate( const RDSize bucket, const RDUInt16 fingerprint ) const;
+
+		/**
+		 *	Store a fingerprint in either of its buckets, displacing others to their alternate
+		 *	buckets as needed. The last fingerprint displaced is held aside if no room is found.
+		 * @param bucket	Either Candidate Bucket
+		 * @param fingerprint	Fingerprint
+		 */
+		void Relocate( RDSize bucket, RDUInt16 fingerprint );
+
+		/**
+		 *	Store a fingerprint in the first free slot of a bucket
+		 * @param bucket	Bucket Index
+		 * @param fingerprint	Fingerprint
+		 * @return		True - If the bucket had a free slot. False otherwise.
+		 */
+		bool Place( const RDSize bucket, const RDUInt16 fingerprint );
+
+		/**
+		 *	Clear the first slot of a bucket holding a fingerprint
+		 * @param bucket	Bucket Index
+		 * @param fingerprint	Fingerprint
+		 * @return		True - If the bucket held the fingerprint. False otherwise.
+		 */
+		bool Erase( const RDSize bucket, const RDUInt16 fingerprint );
+
+		/**
+		 *	Check whether a bucket holds a fingerprint
+		 * @param bucket	Bucket Index
+		 * @param fingerprint	Fingerprint
+		 * @return		True - If the bucket holds the fingerprint. False otherwise.
+		 */
+		bool Holds( const RDSize bucket, const RDUInt16 fingerprint ) const;
+
+		/**
+		 *	Read the fingerprint in a slot. Empty slots read as zero.
+		 * @param slot	Slot Index
+		 * @return	Fingerprint
+		 */
+		RDUInt16 Slot( const RDSize slot ) const;
+
+		/**
+		 *	Write the fingerprint in a slot
+		 * @param slot		Slot Index
+		 * @param fingerprint	Fingerprint, or zero to empty the slot
+		 */
+		void Slot( const RDSize slot, const RDUInt16 fingerprint );
+
+		/// Packed Fingerprint Table
+		std::vector<RDUByte8>	m_table;
+		/// Number of Buckets
+		RDSize			m_bucketCount;
+		/// Fingerprint Size in Bits
+		RDSize			m_fingerprintBits;
+		/// Number of Elements held
+		RDSize			m_count;
+		/// Whether a fingerprint displaced by a failed insertion is held aside
+		bool			m_hasVictim;
+		/// Bucket of the displaced fingerprint
+		RDSize			m_victimBucket;
+		/// Displaced Fingerprint
+		RDUInt16		m_victim;
+	};
+} }
+
+#endif // RD_SDRP_CUCKOO_FILTER_H
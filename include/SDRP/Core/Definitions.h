@@ -16,5 +16,15 @@
 
 #define RD_SDRP_UNSPECIFIED_ADDRESS	0xFFFF
 
+/// Bytes of table storage embedded in every bloom filter. Tables which fit are never heap allocated.
+#ifndef RD_SDRP_BLOOM_FILTER_INLINE_BYTES
+#define RD_SDRP_BLOOM_FILTER_INLINE_BYTES	128
+#endif
+
+/// Defined when the compiler supports rvalue references
+#if __cplusplus >= 201103L || ( defined( _MSC_VER ) && _MSC_VER >= 1600 )
+#define RD_SDRP_MOVE_SEMANTICS
+#endif
+
 #endif // RD_SDRP_DEFINITIONS_H
  
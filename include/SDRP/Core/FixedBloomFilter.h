@@ -0,0 +1,373 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_FIXED_BLOOM_FILTER_H
+#define RD_SDRP_FIXED_BLOOM_FILTER_H
+
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/Macros.h>
+#include <SDRP/Core/BloomFilter.h>
+#include <SDRP/Core/ISerializable.h>
+#include <SDRP/Utilities/FilterCodec.h>
+#include <SDRP/Utilities/MurmurHash.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	A membership bloom filter whose geometry is fixed at compile time. The table is held
+	 *	inline as one bit per slot and probed exactly as a chained-hashing, modulo-reduced
+	 *	BloomFilter of the same size is, so the two may be converted into one another and
+	 *	share a wire format. Does not support removal of individual elements.
+	 *
+	 *	Slots must be below eight or a whole number of bytes, as serialized tables are.
+	 *
+	 *	Packet and node filters remain dynamic, since their geometry is chosen at run time by
+	 *	automatic sizing and by the layout, hashing and reduction defaults. Those small enough to
+	 *	have a build time geometry already fit the BloomFilter's inline table.
+	 */
+	template< RDSize Slots, RDSize Hashes >
+	class FixedBloomFilter : public ISerializable
+	{
+	public:
+
+		/**
+		 *	Default Constructor. Creates an empty filter.
+		 */
+		FixedBloomFilter()
+		{
+			Clear();
+		}
+
+		/**
+		 *	Construct a fixed filter holding the elements of a dynamic filter
+		 * @param filter	Filter to be copied. Must probe with chained hashing and modulo
+		 *			reduction over Slots slots with Hashes hashes. Blocked filters
+		 *			qualify only while they fit in a single block.
+		 */
+		explicit FixedBloomFilter( const BloomFilter& filter ) throw( BloomFilterSizeMismatchException )
+		{
+			if( 	filter.TableSize() != Slots || filter.HashCount() != Hashes ||
+				( filter.Layout() == BloomFilter::Blocked && Slots > BloomFilter::BlockSlots ) ||
+				filter.Hashing() != BloomFilter::ChainedHashing ||
+				filter.Reduction() != BloomFilter::ModuloReduction )
+			{
+				throw BloomFilterSizeMismatchException();
+			}
+
+			Clear();
+
+			for( RDSize slot = 0; slot < Slots; slot++ )
+			{
+				if( filter.Check( slot ) )
+				{
+					Set( slot );
+				}
+			}
+		}
+
+		/**
+		 *	Insert an identifier into the filter
+		 * @param id	Identifier to be inserted
+		 */
+		FixedBloomFilter& Insert( const RDIdentifier id )
+		{
+			RDUInt32 hash = 0;
+
+			for( RDSize i = 0; i < Hashes; i++ )
+			{
+				hash = MurmurHash::Hash( id, hash );
+				Set( hash % Slots );
+			}
+
+			return ( *this );
+		}
+
+		/**
+		 *	Check whether the filter contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If the filter contains the identifier. False otherwise.
+		 */
+		bool Contains( const RDIdentifier id ) const
+		{
+			RDUInt32 hash = 0;
+
+			for( RDSize i = 0; i < Hashes; i++ )
+			{
+				hash = MurmurHash::Hash( id, hash );
+
+				if( Check( hash % Slots ) == false )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 *	Check whether the filter contains all of the elements in another filter
+		 * @param other	Other Filter
+		 * @return	True - If this filter contains all of the elements in \a other. False otherwise.
+		 */
+		bool Contains( const FixedBloomFilter& other ) const
+		{
+			for( RDSize i = 0; i < Bytes; i++ )
+			{
+				if( ( other.m_bits[ i ] & ~m_bits[ i ] ) != 0 )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 *	Check whether the filter contains any elements
+		 * @return	True - If the filter contains any elements. False otherwise.
+		 */
+		bool HasElements() const
+		{
+			for( RDSize i = 0; i < Bytes; i++ )
+			{
+				if( m_bits[ i ] != 0 )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/**
+		 *	Get the number of slots set in this filter
+		 * @return	Number of set slots
+		 */
+		const RDSize SetBytes() const
+		{
+			RDSize count = 0;
+
+			for( RDSize slot = 0; slot < Slots; slot++ )
+			{
+				count += Check( slot ) ? 1 : 0;
+			}
+
+			return count;
+		}
+
+		/**
+		 *	Get the size of the filter in slots
+		 * @return	Table Size
+		 */
+		const RDSize TableSize() const
+		{
+			return Slots;
+		}
+
+		/**
+		 *	Get the number of hashes used for filter insertions
+		 * @return 	Hash count
+		 */
+		const RDSize HashCount() const
+		{
+			return Hashes;
+		}
+
+		/**
+		 *	Clear all elements from the filter
+		 */
+		FixedBloomFilter& Clear()
+		{
+			for( RDSize i = 0; i < Bytes; i++ )
+			{
+				m_bits[ i ] = 0x00;
+			}
+
+			return ( *this );
+		}
+
+		/**
+		 *	Set every slot in the filter, such that it contains every identifier
+		 */
+		FixedBloomFilter& Universe()
+		{
+			Clear();
+
+			for( RDSize slot = 0; slot < Slots; slot++ )
+			{
+				Set( slot );
+			}
+
+			return ( *this );
+		}
+
+		/**
+		 *	Add all of the elements in another filter to this one
+		 * @param other	Other Filter
+		 */
+		FixedBloomFilter& operator|=( const FixedBloomFilter& other )
+		{
+			for( RDSize i = 0; i < Bytes; i++ )
+			{
+				m_bits[ i ] |= other.m_bits[ i ];
+			}
+
+			return ( *this );
+		}
+
+		/**
+		 *	Retain only the elements of this filter which are also in another filter
+		 * @param other	Other Filter
+		 */
+		FixedBloomFilter& operator&=( const FixedBloomFilter& other )
+		{
+			for( RDSize i = 0; i < Bytes; i++ )
+			{
+				m_bits[ i ] &= other.m_bits[ i ];
+			}
+
+			return ( *this );
+		}
+
+		bool operator==( const FixedBloomFilter& other ) const
+		{
+			for( RDSize i = 0; i < Bytes; i++ )
+			{
+				if( m_bits[ i ] != other.m_bits[ i ] )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool operator!=( const FixedBloomFilter& other ) const
+		{
+			return !( ( *this ) == other );
+		}
+
+		/**
+		 *	Fill a dynamic filter with the elements of this filter. Each set slot becomes a counter of one.
+		 * @param filter	Filter to be filled
+		 */
+		void Materialize( BloomFilter& filter ) const
+		{
+			filter.m_layout = BloomFilter::Counting;
+			filter.m_hashing = BloomFilter::ChainedHashing;
+			filter.m_reduction = BloomFilter::ModuloReduction;
+			filter.Initialize( Slots, Hashes );
+
+			for( RDSize slot = 0; slot < Slots; slot++ )
+			{
+				if( Check( slot ) )
+				{
+					filter.Set( slot );
+				}
+			}
+		}
+
+		/**
+		 *	Serialize this filter in the same format as an equivalent BloomFilter
+		 * @param buffer	Data buffer into which the object should be serialized
+		 * @param bufferSize	Size of the data buffer in bytes
+		 * @param offset	Offset into the buffer at which serialization should begin
+		 * @param newOffset	New offset produced by serialization
+		 * @return		True - If serialization was successful. False otherwise.
+		 */
+		virtual bool Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const
+		{
+			FilterCodec::Encoding encoding = BloomFilter::CompressTables ? FilterCodec::Select( m_bits, Bytes ) : FilterCodec::Raw;
+			RDSize hashCount = BloomFilter::EncodeFormat( 	Hashes, BloomFilter::Counting, BloomFilter::ChainedHashing,
+									BloomFilter::ModuloReduction, encoding );
+
+			return 	BloomFilter::SerializeHeader( buffer, bufferSize, offset, newOffset, Slots, hashCount ) &&
+				FilterCodec::Encode( buffer, bufferSize, newOffset, newOffset, m_bits, Bytes, encoding );
+		}
+
+		/**
+		 *	Deserialize this filter from the provided data buffer. Filters the constructor would
+		 *	not accept are rejected.
+		 * @param buffer	Data buffer from which the object should be deserialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which deserialization should begin
+		 * @param newOffset	New offset produced by deserializing the object
+		 * @return		True - If deserialization was successful. False otherwise.
+		 */
+		virtual bool Deserialize( 	const RDUByte8* buffer,
+		 				const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset )
+		{
+			RDSize tableSize, hashCount;
+
+			if( BloomFilter::DeserializeHeader( buffer, bufferSize, offset, newOffset, tableSize, hashCount ) )
+			{
+				BloomFilter::TableLayout layout;
+				BloomFilter::HashScheme hashing;
+				BloomFilter::IndexReduction reduction;
+				FilterCodec::Encoding encoding;
+
+				hashCount = BloomFilter::DecodeFormat( hashCount, layout, hashing, reduction, encoding );
+
+				if( 	tableSize != Slots || hashCount != Hashes ||
+					( layout == BloomFilter::Blocked && Slots > BloomFilter::BlockSlots ) ||
+					hashing != BloomFilter::ChainedHashing || reduction != BloomFilter::ModuloReduction )
+				{
+					RD_PRINT( "Serialized Filter does not match the Fixed Filter Geometry" );
+					return false;
+				}
+
+				return FilterCodec::Decode( buffer, bufferSize, newOffset, newOffset, m_bits, Bytes, encoding );
+			}
+			else
+			{
+				RD_PRINT( "Failed to Deserialize Table Size and Hash Count" );
+			}
+
+			return false;
+		}
+
+	private:
+
+		/// Number of bytes in the table, padded to the serialized table size
+		enum { Bytes = Slots < 8 ? 8 : Slots / 8 };
+
+		/// Compile-time check that the table has at least one slot and packs into whole bytes
+		typedef char GeometryIsSerializable[ Slots > 0 && ( Slots < 8 || Slots % 8 == 0 ) ? 1 : -1 ];
+
+		/**
+		 *	Check whether the specified slot is set
+		 * @param slot	Slot Index
+		 * @return	True - If the slot is set. False otherwise.
+		 */
+		bool Check( const RDSize slot ) const
+		{
+			return ( m_bits[ slot / 8 ] >> ( slot % 8 ) ) & 0x01;
+		}
+
+		/**
+		 *	Set the specified slot
+		 * @param slot	Slot Index
+		 */
+		void Set( const RDSize slot )
+		{
+			m_bits[ slot / 8 ] |= static_cast<RDUByte8>( 0x01 << ( slot % 8 ) );
+		}
+
+		/// Packed Slot Bits
+		RDUByte8	m_bits[ Bytes ];
+	};
+} }
+
+#endif // RD_SDRP_FIXED_BLOOM_FILTER_H
@@ -0,0 +1,51 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_IALLOCATOR_H
+#define RD_SDRP_IALLOCATOR_H
+
+#include <SDRP/Core/Types.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	Common interface for allocators of filter tables and scratch buffers. Blocks are released
+	 *	with the size they were allocated with.
+	 */
+	class IAllocator
+	{
+	public:
+
+		virtual ~IAllocator() {}
+
+		/**
+		 *	Allocate a block of memory, aligned for any fundamental type
+		 * @param bytes	Block Size in Bytes
+		 * @return	Block
+		 */
+		virtual void* Allocate( const RDSize bytes ) = 0;
+
+		/**
+		 *	Release a block of memory allocated by this allocator
+		 * @param block	Block
+		 * @param bytes	Block Size in Bytes, as allocated
+		 */
+		virtual void Release( void* block, const RDSize bytes ) = 0;
+
+		/**
+		 *	Check whether blocks stay valid until released. Blocks from allocators which reclaim
+		 *	memory wholesale, such as scratch arenas, are never shared beyond their owner.
+		 * @return	True - If blocks stay valid until released. False otherwise.
+		 */
+		virtual bool Persistent() const = 0;
+	};
+} }
+
+#endif // RD_SDRP_IALLOCATOR_H
@@ -0,0 +1,70 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_IIDENTIFIER_SET_H
+#define RD_SDRP_IIDENTIFIER_SET_H
+
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/ISerializable.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	Common interface for approximate sets of identifiers which support removal. Membership
+	 *	queries may give false positives, but never false negatives.
+	 */
+	class IIdentifierSet : public ISerializable
+	{
+	public:
+
+		virtual ~IIdentifierSet() {}
+
+		/**
+		 *	Insert the provided identifier into the set
+		 * @param id	Identifier to be inserted
+		 * @return	True - If the identifier was inserted. False if the set is full.
+		 */
+		virtual bool Insert( const RDIdentifier id ) = 0;
+
+		/**
+		 *	Remove the provided identifier from the set. Only identifiers which were inserted
+		 *	may be removed.
+		 * @param id	Identifier to be removed
+		 * @return	True - If the identifier was found and removed. False otherwise.
+		 */
+		virtual bool Remove( const RDIdentifier id ) = 0;
+
+		/**
+		 *	Check whether the set contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If the set contains the identifier. False otherwise.
+		 */
+		virtual bool Contains( const RDIdentifier id ) const = 0;
+
+		/**
+		 *	Check whether the set contains any elements
+		 * @return	True - If the set contains any elements. False otherwise.
+		 */
+		virtual bool HasElements() const = 0;
+
+		/**
+		 *	Clear all elements from the set
+		 */
+		virtual void Clear() = 0;
+
+		/**
+		 *	Get the memory held by the set's table
+		 * @return	Table Size in Bytes
+		 */
+		virtual const RDSize Footprint() const = 0;
+	};
+} }
+
+#endif // RD_SDRP_IIDENTIFIER_SET_H
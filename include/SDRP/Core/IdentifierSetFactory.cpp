@@ -0,0 +1,37 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/IdentifierSetFactory.h>
+
+#include <SDRP/Core/CuckooFilter.h>
+#include <SDRP/Core/BloomFilterSet.h>
+
+namespace Radicle { namespace SDRP
+{
+	IdentifierSetFactory::SetBackend IdentifierSetFactory::DefaultBackend = IdentifierSetFactory::Bloom;
+
+	IdentifierSetFactory::IdentifierSetPtr IdentifierSetFactory::Create( 	const IdentifierSetFactory::SetBackend backend,
+										const RDSize numElements,
+										const RDDouble falsePositiveRate )
+	{
+		IdentifierSetPtr set;
+
+		if( backend == IdentifierSetFactory::Cuckoo )
+		{
+			set.reset( new CuckooFilter( numElements, falsePositiveRate ) );
+		}
+		else
+		{
+			set.reset( new BloomFilterSet( numElements, falsePositiveRate ) );
+		}
+
+		return set;
+	}
+} }
@@ -0,0 +1,62 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_IDENTIFIER_SET_FACTORY_H
+#define RD_SDRP_IDENTIFIER_SET_FACTORY_H
+
+#include <memory>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/Definitions.h>
+#include <SDRP/Core/BloomFilter.h>
+#include <SDRP/Core/IIdentifierSet.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	Factory class for Identifier Sets. Sets are held locally only, as the filters sent in
+	 *	beacons and advertisements must remain bloom filters for peers to read them.
+	 */
+	class IdentifierSetFactory
+	{
+	public:
+
+		/// Identifier Set Owning Pointer Type. Auto-pointers are deprecated where move semantics are supported.
+#ifdef RD_SDRP_MOVE_SEMANTICS
+		typedef std::unique_ptr<IIdentifierSet>	IdentifierSetPtr;
+#else
+		typedef std::auto_ptr<IIdentifierSet>	IdentifierSetPtr;
+#endif
+
+		/// Possible Set Representations
+		enum SetBackend
+		{
+			/// Counting Bloom Filter
+			Bloom,
+			/// Cuckoo Filter
+			Cuckoo
+		};
+
+		/// Representation used when none is specified
+		static SetBackend	DefaultBackend;
+
+		/**
+		 *	Create an empty identifier set
+		 * @param backend		Set Representation
+		 * @param numElements		Number of Elements to be Contained
+		 * @param falsePositiveRate	Maximum False Positive Rate
+		 * @return			Identifier Set
+		 */
+		static IdentifierSetPtr Create( const SetBackend backend = DefaultBackend,
+						const RDSize numElements = BloomFilter::PredictedElementCount,
+						const RDDouble falsePositiveRate = BloomFilter::DesiredFalsePositiveRate );
+	};
+} }
+
+#endif // RD_SDRP_IDENTIFIER_SET_FACTORY_H
@@ -0,0 +1,86 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+
+#include <SDRP/Core/MinHashSketch.h>
+#include <SDRP/Utilities/MurmurHash.h>
+
+namespace Radicle { namespace SDRP
+{
+	const RDSize	MinHashSketch::Bins		= 48;
+	const RDSize	MinHashSketch::BandRows		= 4;
+
+	namespace
+	{
+		/// Value held by a bin which received no hash
+		const RDUInt32 EmptyBin = 0xFFFFFFFF;
+	}
+
+	MinHashSketch::MinHashSketch() :
+	m_tableSize( 0 ),
+	m_hashCount( 0 )
+	{}
+
+	MinHashSketch::MinHashSketch( const BloomFilter& filter ) :
+	m_minima( Bins, EmptyBin ),
+	m_tableSize( filter.TableSize() ),
+	m_hashCount( filter.HashCount() )
+	{
+		// A single hash per slot picks both the bin and the value it competes with
+		for( RDSize slot = 0; slot < m_tableSize; slot++ )
+		{
+			if( filter.Check( slot ) )
+			{
+				RDUInt32 hash = MurmurHash::Hash( static_cast<RDUInt32>( slot ), 0 );
+				RDUInt32& minimum = m_minima[ hash % Bins ];
+
+				minimum = hash < minimum ? hash : minimum;
+			}
+		}
+	}
+
+	bool MinHashSketch::Comparable( const MinHashSketch& other ) const
+	{
+		return 	m_minima.size() > 0 && other.m_minima.size() == m_minima.size() &&
+			m_tableSize == other.m_tableSize && m_hashCount == other.m_hashCount;
+	}
+
+	RDDouble MinHashSketch::Similarity( const MinHashSketch& other ) const
+	{
+		if( Comparable( other ) == false )
+		{
+			return 0.0;
+		}
+
+		RDSize filled = 0, agreed = 0;
+
+		for( RDSize bin = 0; bin < m_minima.size(); bin++ )
+		{
+			if( m_minima[ bin ] != EmptyBin || other.m_minima[ bin ] != EmptyBin )
+			{
+				filled++;
+				agreed += m_minima[ bin ] == other.m_minima[ bin ] ? 1 : 0;
+			}
+		}
+
+		return filled == 0 ? 1.0 : static_cast<RDDouble>( agreed ) / filled;
+	}
+
+	RDSize MinHashSketch::BandCount() const
+	{
+		return m_minima.size() / BandRows;
+	}
+
+	RDUInt32 MinHashSketch::Band( const RDSize band ) const
+	{
+		// Keys depend on the bins alone, so sketches of filters folded to a common size share them
+		return MurmurHash::Hash( reinterpret_cast<const RDUByte8*>( &m_minima[ band * BandRows ] ), BandRows * sizeof( RDUInt32 ), static_cast<RDUInt32>( band ) );
+	}
+} }
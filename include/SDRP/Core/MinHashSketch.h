@@ -0,0 +1,92 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+
+#ifndef RD_SDRP_MIN_HASH_SKETCH_H
+#define RD_SDRP_MIN_HASH_SKETCH_H
+
+#include <vector>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/BloomFilter.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	A MinHash sketch of the slots set in a bloom filter. Each set slot is hashed once and falls
+	 *	into one of a fixed number of bins, each bin keeping the smallest hash it receives. The
+	 *	fraction of bins two sketches agree on estimates the Jaccard similarity of the two filters'
+	 *	set slots, and groups of bins (bands) may be used as keys to find filters which are likely
+	 *	similar without comparing every pair. Sketches are only comparable between filters sharing
+	 *	a table size and hash count.
+	 */
+	class MinHashSketch
+	{
+	public:
+
+		/// Number of Bins in each Sketch
+		const static RDSize	Bins;
+		/// Number of Bins hashed together into each Band
+		const static RDSize	BandRows;
+
+		/**
+		 *	Default Constructor. Creates an empty sketch, comparable with no other.
+		 */
+		MinHashSketch();
+
+		/**
+		 *	Initializing Constructor
+		 * @param filter	Bloom Filter to be Sketched
+		 */
+		MinHashSketch( const BloomFilter& filter );
+
+		/**
+		 *	Check whether this sketch may be compared with another
+		 * @param other	Other Sketch
+		 * @return	True - If both sketches were taken of filters sharing a table size and
+		 *		hash count. False otherwise.
+		 */
+		bool Comparable( const MinHashSketch& other ) const;
+
+		/**
+		 *	Estimate the Jaccard similarity between the slots set in the filters sketched by this
+		 *	sketch and another
+		 * @param other	Other Sketch
+		 * @return	Fraction of bins filled in either sketch on which both agree, or zero if the
+		 *		sketches are not comparable. Two sketches of empty filters are considered identical.
+		 */
+		RDDouble Similarity( const MinHashSketch& other ) const;
+
+		/**
+		 *	Get the number of bands in the sketch
+		 * @return	Band Count
+		 */
+		RDSize BandCount() const;
+
+		/**
+		 *	Get a key for the specified band. Sketches which agree on every bin of a band share its
+		 *	key, whatever the geometry of the filters sketched, so filters should be folded to a
+		 *	common size before sketching if their keys are to be matched.
+		 * @param band	Band Index
+		 * @return	Band Key
+		 */
+		RDUInt32 Band( const RDSize band ) const;
+
+	private:
+
+		/// Smallest Hash received by each Bin
+		std::vector<RDUInt32>	m_minima;
+		/// Table Size of the Sketched Filter
+		RDSize			m_tableSize;
+		/// Hash Count of the Sketched Filter
+		RDSize			m_hashCount;
+	};
+} }
+
+#endif // RD_SDRP_MIN_HASH_SKETCH_H
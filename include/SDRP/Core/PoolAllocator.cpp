@@ -0,0 +1,135 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/PoolAllocator.h>
+#include <cstddef>
+#include <new>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace Radicle { namespace SDRP
+{
+	const RDSize	PoolAllocator::MinimumBlock		= 64;
+	const RDSize	PoolAllocator::MaximumBlock		= 65536;
+	const RDSize	PoolAllocator::MaximumFreeBlocks	= 64;
+
+	PoolAllocator* PoolAllocator::m_instance = NULL;
+
+	PoolAllocator* PoolAllocator::Instance()
+	{
+		if( m_instance == NULL )
+		{
+			m_instance = new PoolAllocator();
+		}
+
+		return m_instance;
+	}
+
+	PoolAllocator::PoolAllocator() :
+	m_lock( 0 )
+	{
+		m_free.resize( static_cast<size_t>( SizeClass( MaximumBlock ) + 1 ) );
+
+		// Free lists never grow once reserved, so releasing a block never allocates
+		for( RDSize i = 0; i < m_free.size(); i++ )
+		{
+			m_free[ i ].reserve( static_cast<size_t>( MaximumFreeBlocks ) );
+		}
+	}
+
+	void* PoolAllocator::Allocate( const RDSize bytes )
+	{
+		RDSize sizeClass = SizeClass( bytes );
+
+		if( sizeClass >= m_free.size() )
+		{
+			return ::operator new( static_cast<size_t>( bytes ) );
+		}
+
+		void* block = NULL;
+
+		Lock();
+
+		if( m_free[ sizeClass ].empty() == false )
+		{
+			block = m_free[ sizeClass ].back();
+			m_free[ sizeClass ].pop_back();
+		}
+
+		Unlock();
+
+		return block != NULL ? block : ::operator new( static_cast<size_t>( MinimumBlock << sizeClass ) );
+	}
+
+	void PoolAllocator::Release( void* block, const RDSize bytes )
+	{
+		RDSize sizeClass = SizeClass( bytes );
+
+		if( sizeClass < m_free.size() )
+		{
+			Lock();
+
+			if( m_free[ sizeClass ].size() < MaximumFreeBlocks )
+			{
+				m_free[ sizeClass ].push_back( block );
+				block = NULL;
+			}
+
+			Unlock();
+		}
+
+		::operator delete( block );
+	}
+
+	bool PoolAllocator::Persistent() const
+	{
+		return true;
+	}
+
+	RDSize PoolAllocator::SizeClass( const RDSize bytes ) const
+	{
+		RDSize sizeClass = 0;
+
+		while( ( MinimumBlock << sizeClass ) < bytes && ( MinimumBlock << sizeClass ) <= MaximumBlock )
+		{
+			sizeClass++;
+		}
+
+		return sizeClass;
+	}
+
+	void PoolAllocator::Lock()
+	{
+#if defined( __GNUC__ )
+		while( __atomic_exchange_n( &m_lock, 1, __ATOMIC_ACQUIRE ) != 0 )
+		{
+		}
+#elif defined( _MSC_VER )
+		while( _InterlockedExchange( reinterpret_cast<volatile long*>( &m_lock ), 1 ) != 0 )
+		{
+		}
+#else
+		m_lock = 1;
+#endif
+	}
+
+	void PoolAllocator::Unlock()
+	{
+#if defined( __GNUC__ )
+		__atomic_store_n( &m_lock, 0, __ATOMIC_RELEASE );
+#elif defined( _MSC_VER )
+		_InterlockedExchange( reinterpret_cast<volatile long*>( &m_lock ), 0 );
+#else
+		m_lock = 0;
+#endif
+	}
+} }
@@ -0,0 +1,96 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_POOL_ALLOCATOR_H
+#define RD_SDRP_POOL_ALLOCATOR_H
+
+#include <vector>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/IAllocator.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	An allocator which keeps released blocks in free lists by size class, power of two sizes
+	 *	from MinimumBlock to MaximumBlock, so that tables of the sizes a node works with are
+	 *	recycled rather than returned to the heap. Larger blocks come from the heap directly.
+	 *	Free lists are guarded by a spin lock, as filters may be created on any thread.
+	 */
+	class PoolAllocator : public IAllocator
+	{
+	public:
+
+		/// Smallest Block handed out, in Bytes
+		const static RDSize	MinimumBlock;
+		/// Largest Block kept in a free list, in Bytes
+		const static RDSize	MaximumBlock;
+		/// Most released blocks kept in each free list
+		const static RDSize	MaximumFreeBlocks;
+
+		/**
+		 *	Get the shared pool
+		 * @return	Pool Allocator
+		 */
+		static PoolAllocator* Instance();
+
+		/**
+		 *	Allocate a block from the free list of its size class, or the heap if the list is empty
+		 * @param bytes	Block Size in Bytes
+		 * @return	Block
+		 */
+		virtual void* Allocate( const RDSize bytes );
+
+		/**
+		 *	Return a block to the free list of its size class, or the heap if the list is full
+		 * @param block	Block
+		 * @param bytes	Block Size in Bytes, as allocated
+		 */
+		virtual void Release( void* block, const RDSize bytes );
+
+		/**
+		 *	Blocks from a pool stay valid until released
+		 * @return	True
+		 */
+		virtual bool Persistent() const;
+
+	private:
+
+		/**
+		 *	Default Constructor
+		 */
+		PoolAllocator();
+
+		/**
+		 *	Get the size class of a block
+		 * @param bytes	Block Size in Bytes
+		 * @return	Size Class, or the number of size classes for blocks larger than MaximumBlock
+		 */
+		RDSize SizeClass( const RDSize bytes ) const;
+
+		/**
+		 *	Spin until the free lists are held by this thread
+		 */
+		void Lock();
+
+		/**
+		 *	Give up the free lists
+		 */
+		void Unlock();
+
+		/// Singleton Instance
+		static PoolAllocator*			m_instance;
+		/// Released Blocks, by Size Class
+		std::vector< std::vector<void*> >	m_free;
+		/// Free List Lock, set while held
+		volatile RDUInt32			m_lock;
+	};
+} }
+
+#endif // RD_SDRP_POOL_ALLOCATOR_H
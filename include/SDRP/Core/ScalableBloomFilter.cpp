@@ -0,0 +1,217 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/ScalableBloomFilter.h>
+#include <SDRP/Core/Macros.h>
+#include <SDRP/Utilities/Serializer.h>
+#include <cmath>
+#include <algorithm>
+
+namespace Radicle { namespace SDRP
+{
+	const RDDouble	ScalableBloomFilter::TighteningRatio	= 0.5;
+	const RDSize	ScalableBloomFilter::MaximumLayers	= 32;
+
+	ScalableBloomFilter::ScalableBloomFilter( 	const RDSize initialCapacity,
+							const RDDouble falsePositiveRate,
+							const BloomFilter::TableLayout layout ) :
+	m_initialCapacity( initialCapacity ),
+	m_falsePositiveRate( falsePositiveRate >= 1.0 ? BloomFilter::DesiredFalsePositiveRate : falsePositiveRate ),
+	m_layout( layout )
+	{
+		Reset( initialCapacity );
+	}
+
+	RDDouble ScalableBloomFilter::RateForFirstLayer( const RDDouble firstLayerRate )
+	{
+		return firstLayerRate / ( 1.0 - TighteningRatio );
+	}
+
+	void ScalableBloomFilter::Reset( const RDSize initialCapacity )
+	{
+		m_initialCapacity = initialCapacity > 0 ? initialCapacity : 1;
+		m_layers.clear();
+		m_counts.clear();
+		Grow();
+	}
+
+	ScalableBloomFilter& ScalableBloomFilter::Insert( const RDIdentifier id )
+	{
+		if( Contains( id ) == false )
+		{
+			if( m_counts.back() >= Capacity( m_layers.size() - 1 ) )
+			{
+				Grow();
+			}
+
+			m_layers.back().Insert( id );
+			m_counts.back()++;
+		}
+
+		return ( *this );
+	}
+
+	ScalableBloomFilter& ScalableBloomFilter::InsertMany( const RDIdentifier* ids, const RDSize count )
+	{
+		std::vector<RDIdentifier> fresh;
+		fresh.reserve( count );
+
+		for( RDSize i = 0; i < count; i++ )
+		{
+			if( Contains( ids[ i ] ) == false )
+			{
+				fresh.push_back( ids[ i ] );
+			}
+		}
+
+		// Repeats within the batch are not yet in the filter to be found by Contains
+		std::sort( fresh.begin(), fresh.end() );
+		fresh.erase( std::unique( fresh.begin(), fresh.end() ), fresh.end() );
+
+		for( RDSize inserted = 0; inserted < fresh.size(); )
+		{
+			if( m_counts.back() >= Capacity( m_layers.size() - 1 ) )
+			{
+				Grow();
+			}
+
+			RDSize room = Capacity( m_layers.size() - 1 ) - m_counts.back();
+			RDSize batch = fresh.size() - inserted < room ? fresh.size() - inserted : room;
+
+			m_layers.back().InsertMany( &fresh[ inserted ], batch );
+			m_counts.back() += batch;
+			inserted += batch;
+		}
+
+		return ( *this );
+	}
+
+	bool ScalableBloomFilter::Contains( const RDIdentifier id ) const
+	{
+		// Newer layers hold more elements, so are checked first
+		for( RDSize i = m_layers.size(); i > 0; i-- )
+		{
+			if( m_layers[ i - 1 ].Contains( id ) )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ScalableBloomFilter::Clear()
+	{
+		Reset( m_initialCapacity );
+	}
+
+	const RDSize ScalableBloomFilter::ElementCount() const
+	{
+		RDSize count = 0;
+
+		for( RDSize i = 0; i < m_counts.size(); i++ )
+		{
+			count += m_counts[ i ];
+		}
+
+		return count;
+	}
+
+	const RDSize ScalableBloomFilter::LayerCount() const
+	{
+		return m_layers.size();
+	}
+
+	const BloomFilter& ScalableBloomFilter::Layer( const RDSize index ) const
+	{
+		return m_layers[ index ];
+	}
+
+	bool ScalableBloomFilter::Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const
+	{
+		if( 	Serializer::SerializeVarint( buffer, bufferSize, offset, newOffset, m_initialCapacity ) &&
+			Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_layers.size() ) )
+		{
+			for( RDSize i = 0; i < m_layers.size(); i++ )
+			{
+				if( 	Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_counts[ i ] ) == false ||
+					m_layers[ i ].Serialize( buffer, bufferSize, newOffset, newOffset ) == false )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool ScalableBloomFilter::Deserialize( 	const RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset )
+	{
+		RDSize initialCapacity, layerCount;
+
+		if( 	Serializer::DeserializeVarint( buffer, bufferSize, offset, newOffset, initialCapacity ) &&
+			Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, layerCount ) )
+		{
+			if( layerCount == 0 || layerCount > MaximumLayers )
+			{
+				RD_PRINT( "Scalable Filter Layer Count " << layerCount << " is out of range" );
+				return false;
+			}
+
+			m_initialCapacity = initialCapacity > 0 ? initialCapacity : 1;
+			m_layers.resize( layerCount );
+			m_counts.resize( layerCount );
+
+			for( RDSize i = 0; i < layerCount; i++ )
+			{
+				if( 	Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, m_counts[ i ] ) == false ||
+					m_layers[ i ].Deserialize( buffer, bufferSize, newOffset, newOffset ) == false )
+				{
+					RD_PRINT( "Failed to Deserialize Scalable Filter Layer " << i );
+					Reset( m_initialCapacity );
+					return false;
+				}
+			}
+
+			m_layout = m_layers.back().Layout();
+
+			return true;
+		}
+		else
+		{
+			RD_PRINT( "Failed to Deserialize Scalable Filter Header" );
+		}
+
+		return false;
+	}
+
+	void ScalableBloomFilter::Grow()
+	{
+		// Layer rates form a geometric series summing to no more than the target rate
+		RDSize index = m_layers.size();
+		RDDouble falsePositiveRate = m_falsePositiveRate * ( 1.0 - TighteningRatio ) * std::pow( TighteningRatio, static_cast<RDDouble>( index ) );
+
+		m_layers.push_back( BloomFilter( Capacity( index ), falsePositiveRate, m_layout ) );
+		m_counts.push_back( 0 );
+	}
+
+	RDSize ScalableBloomFilter::Capacity( const RDSize index ) const
+	{
+		return m_initialCapacity << index;
+	}
+} }
@@ -0,0 +1,162 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_SCALABLE_BLOOM_FILTER_H
+#define RD_SDRP_SCALABLE_BLOOM_FILTER_H
+
+#include <vector>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/BloomFilter.h>
+#include <SDRP/Core/ISerializable.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	A bloom filter which grows with the number of elements inserted into it. Elements are
+	 *	inserted into the newest of a series of layers, and a new layer of twice the capacity is
+	 *	added whenever the newest fills. Each layer is held to a tighter false positive rate than
+	 *	the last, such that the filter as a whole stays within its target rate however large it grows.
+	 *	Does not support removal of individual elements.
+	 */
+	class ScalableBloomFilter : public ISerializable
+	{
+	public:
+
+		/// Ratio by which the false positive rate of each layer is tightened relative to the last
+		const static RDDouble		TighteningRatio;
+		/// Most layers accepted when deserializing a filter
+		const static RDSize		MaximumLayers;
+
+		/**
+		 *	Default Constructor
+		 * @param initialCapacity	Number of Elements held by the first layer
+		 * @param falsePositiveRate	Maximum False Positive Rate of the whole filter
+		 * @param layout		Table Layout of every layer
+		 */
+		ScalableBloomFilter( 	const RDSize initialCapacity = BloomFilter::PredictedElementCount,
+					const RDDouble falsePositiveRate = BloomFilter::DesiredFalsePositiveRate,
+					const BloomFilter::TableLayout layout = BloomFilter::Counting );
+
+		/**
+		 *	Get the false positive rate of a whole filter whose first layer is held to the given rate.
+		 *	Filters which are consolidated into a single layer before being sent are built this way,
+		 *	such that the layer sent is held to the configured rate rather than a tightened one.
+		 * @param firstLayerRate	False Positive Rate of the First Layer
+		 * @return			False Positive Rate of the Whole Filter
+		 */
+		static RDDouble RateForFirstLayer( const RDDouble firstLayerRate );
+
+		/**
+		 *	Clear all elements from the filter, leaving a single empty layer of the given capacity
+		 * @param initialCapacity	Number of Elements held by the first layer
+		 */
+		void Reset( const RDSize initialCapacity );
+
+		/**
+		 *	Insert the provided identifier into the filter, unless the filter already contains it
+		 * @param id	Identifier to be inserted
+		 */
+		ScalableBloomFilter& Insert( const RDIdentifier id );
+
+		/**
+		 *	Insert many identifiers into the filter. As with Insert, identifiers the filter already
+		 *	contains are skipped, and count towards layer capacity only once.
+		 * @param ids	Identifiers to be inserted
+		 * @param count	Number of identifiers
+		 */
+		ScalableBloomFilter& InsertMany( const RDIdentifier* ids, const RDSize count );
+
+		/**
+		 *	Check whether the filter contains the given identifier
+		 * @param id	Identifier to be checked
+		 * @return	True - If any layer contains the identifier. False otherwise.
+		 */
+		bool Contains( const RDIdentifier id ) const;
+
+		/**
+		 *	Clear all elements from the filter, leaving a single empty layer
+		 */
+		void Clear();
+
+		/**
+		 *	Get the number of elements inserted into the filter
+		 * @return	Element Count
+		 */
+		const RDSize ElementCount() const;
+
+		/**
+		 *	Get the number of layers in the filter
+		 * @return	Layer Count
+		 */
+		const RDSize LayerCount() const;
+
+		/**
+		 *	Get the specified layer
+		 * @param index	Layer Index, the oldest first
+		 * @return	Layer Filter
+		 */
+		const BloomFilter& Layer( const RDSize index ) const;
+
+		/**
+		 *	Serialize this filter into the provided data buffer. The first layer's capacity and the
+		 *	number of layers are written as varints, followed by each layer's element count as a
+		 *	varint and the layer itself.
+		 * @param buffer	Data buffer into which the object should be serialized
+		 * @param bufferSize	Size of the data buffer in bytes
+		 * @param offset	Offset into the buffer at which serialization should begin
+		 * @param newOffset	New offset produced by serialization
+		 * @return		True - If serialization was successful. False otherwise.
+		 */
+		virtual bool Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const;
+
+		/**
+		 *	Deserialize this filter from the provided data buffer
+		 * @param buffer	Data buffer from which the object should be deserialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which deserialization should begin
+		 * @param newOffset	New offset produced by deserializing the object
+		 * @return		True - If deserialization was successful. False otherwise.
+		 */
+		virtual bool Deserialize( 	const RDUByte8* buffer,
+		 				const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset );
+
+	private:
+
+		/**
+		 *	Add a new, empty layer with twice the capacity of the newest layer
+		 */
+		void Grow();
+
+		/**
+		 *	Get the number of elements the specified layer was sized for
+		 * @param index	Layer Index
+		 * @return	Layer Capacity
+		 */
+		RDSize Capacity( const RDSize index ) const;
+
+		/// Layers, the oldest first
+		std::vector<BloomFilter>	m_layers;
+		/// Number of Elements inserted into each Layer
+		std::vector<RDSize>		m_counts;
+		/// Number of Elements held by the first Layer
+		RDSize				m_initialCapacity;
+		/// Maximum False Positive Rate of the whole Filter
+		RDDouble			m_falsePositiveRate;
+		/// Table Layout of every Layer
+		BloomFilter::TableLayout	m_layout;
+	};
+} }
+
+#endif // RD_SDRP_SCALABLE_BLOOM_FILTER_H
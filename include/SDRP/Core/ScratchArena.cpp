@@ -0,0 +1,104 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Core/ScratchArena.h>
+#include <cstddef>
+
+namespace Radicle { namespace SDRP
+{
+	const RDSize ScratchArena::ChunkBytes = 16384;
+
+	namespace
+	{
+		/// Alignment of every block handed out, enough for any fundamental type
+		const RDSize Alignment = 16;
+	}
+
+	ScratchArena::ScratchArena() :
+	m_current( 0 ),
+	m_offset( 0 ),
+	m_used( 0 )
+	{}
+
+	ScratchArena::~ScratchArena()
+	{
+		for( RDSize i = 0; i < m_chunks.size(); i++ )
+		{
+			delete[] m_chunks[ i ];
+		}
+	}
+
+	void* ScratchArena::Allocate( const RDSize bytes )
+	{
+		RDSize aligned = ( bytes + Alignment - 1 ) & ~( Alignment - 1 );
+
+		// Move on through the chunks kept from earlier packets until one has room
+		while( m_current < m_chunks.size() && m_offset + aligned > m_sizes[ m_current ] )
+		{
+			m_current++;
+			m_offset = 0;
+		}
+
+		if( m_current == m_chunks.size() )
+		{
+			RDSize size = aligned > ChunkBytes ? aligned : ChunkBytes;
+
+			m_chunks.push_back( new RDUByte8[ static_cast<size_t>( size ) ] );
+			m_sizes.push_back( size );
+			m_offset = 0;
+		}
+
+		void* block = m_chunks[ m_current ] + m_offset;
+
+		m_offset += aligned;
+		m_used += aligned;
+
+		return block;
+	}
+
+	void ScratchArena::Release( void*, const RDSize )
+	{
+		// Blocks are reclaimed together by Reset
+	}
+
+	bool ScratchArena::Persistent() const
+	{
+		return false;
+	}
+
+	void ScratchArena::Reset()
+	{
+		RDSize kept = 0;
+
+		for( RDSize i = 0; i < m_chunks.size(); i++ )
+		{
+			if( m_sizes[ i ] > ChunkBytes )
+			{
+				delete[] m_chunks[ i ];
+				continue;
+			}
+
+			m_chunks[ kept ] = m_chunks[ i ];
+			m_sizes[ kept ] = m_sizes[ i ];
+			kept++;
+		}
+
+		m_chunks.resize( static_cast<size_t>( kept ) );
+		m_sizes.resize( static_cast<size_t>( kept ) );
+		m_current = 0;
+		m_offset = 0;
+		m_used = 0;
+	}
+
+	const RDSize ScratchArena::Used() const
+	{
+		return m_used;
+	}
+} }
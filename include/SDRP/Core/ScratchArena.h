@@ -0,0 +1,96 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_SCRATCH_ARENA_H
+#define RD_SDRP_SCRATCH_ARENA_H
+
+#include <vector>
+#include <SDRP/Core/Types.h>
+#include <SDRP/Core/IAllocator.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	An allocator which hands out blocks from the front of large chunks and reclaims them all at
+	 *	once when reset. Suited to the filters and buffers created while handling a single packet.
+	 *	Releasing a block does nothing, so anything allocated from the arena must be destroyed or
+	 *	copied elsewhere before the arena is reset. Not safe for use from more than one thread.
+	 */
+	class ScratchArena : public IAllocator
+	{
+	public:
+
+		/// Size of each Chunk in Bytes. Larger blocks are given chunks of their own.
+		const static RDSize	ChunkBytes;
+
+		/**
+		 *	Default Constructor
+		 */
+		ScratchArena();
+
+		/**
+		 *	Destructor. Frees every chunk.
+		 */
+		virtual ~ScratchArena();
+
+		/**
+		 *	Allocate a block from the current chunk, moving to the next if it is full
+		 * @param bytes	Block Size in Bytes
+		 * @return	Block
+		 */
+		virtual void* Allocate( const RDSize bytes );
+
+		/**
+		 *	Blocks are reclaimed when the arena is reset, so releasing one does nothing
+		 * @param block	Block
+		 * @param bytes	Block Size in Bytes, as allocated
+		 */
+		virtual void Release( void* block, const RDSize bytes );
+
+		/**
+		 *	Blocks from an arena are invalidated when it is reset
+		 * @return	False
+		 */
+		virtual bool Persistent() const;
+
+		/**
+		 *	Reclaim every block allocated from the arena. Chunks of the standard size are kept
+		 *	for reuse, and oversized chunks are freed.
+		 */
+		void Reset();
+
+		/**
+		 *	Get the number of bytes allocated since the arena was last reset
+		 * @return	Bytes Allocated
+		 */
+		const RDSize Used() const;
+
+	private:
+
+		/**
+		 *	Copy Constructor and Assignment. Arenas own their chunks, so are not copied.
+		 */
+		ScratchArena( const ScratchArena& other );
+		ScratchArena& operator=( const ScratchArena& other );
+
+		/// Chunks, in the order they were first used
+		std::vector<RDUByte8*>	m_chunks;
+		/// Size of each Chunk in Bytes
+		std::vector<RDSize>	m_sizes;
+		/// Index of the Chunk being allocated from
+		RDSize			m_current;
+		/// Offset of the first free byte in the current Chunk
+		RDSize			m_offset;
+		/// Bytes allocated since the last reset
+		RDSize			m_used;
+	};
+} }
+
+#endif // RD_SDRP_SCRATCH_ARENA_H
@@ -17,6 +17,12 @@ namespace Radicle { namespace SDRP
 	Beacon::Beacon() :
 	m_source( RD_SDRP_UNSPECIFIED_ADDRESS )
 	{}
+
+	Beacon::Beacon( IAllocator& allocator ) :
+	m_source( RD_SDRP_UNSPECIFIED_ADDRESS )
+	{
+		m_neighbours.Allocator( allocator );
+	}
 	
 	Beacon::Beacon(	const RDNetworkAddress source,
 			const BloomFilter& neighbours ):
@@ -29,6 +29,13 @@ namespace Radicle { namespace SDRP
 		 *	Default Constructor
 		 */
 		Beacon();
+
+		/**
+		 *	Scratch Constructor. The neighbour filter's table is allocated from the given allocator,
+		 *	so a beacon built on a scratch arena must not outlive the arena's next reset.
+		 * @param allocator	Neighbour Filter Allocator
+		 */
+		explicit Beacon( IAllocator& allocator );
 		
 		/**
 		 *	Initializing Constructor
@@ -0,0 +1,143 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Packets/BeaconDelta.h>
+#include <SDRP/Utilities/Serializer.h>
+
+namespace Radicle { namespace SDRP
+{
+	const RDUByte8 BeaconDelta::Type = 0x02;
+
+	BeaconDelta::BeaconDelta() :
+	m_source( RD_SDRP_UNSPECIFIED_ADDRESS ),
+	m_sequence( 0 ),
+	m_base( 0 )
+	{}
+	
+	BeaconDelta::BeaconDelta(	const RDNetworkAddress source,
+					const RDUInt16 sequence,
+					const RDSize base,
+					const std::vector<RDSize>& slots ) :
+	m_source( source ),
+	m_sequence( sequence ),
+	m_base( base ),
+	m_slots( slots )
+	{}
+	
+	const RDNetworkAddress BeaconDelta::Source() const
+	{
+		return m_source;
+	}
+
+	const RDUInt16 BeaconDelta::Sequence() const
+	{
+		return m_sequence;
+	}
+
+	const RDSize BeaconDelta::Base() const
+	{
+		return m_base;
+	}
+
+	const std::vector<RDSize>& BeaconDelta::Slots() const
+	{
+		return m_slots;
+	}
+	
+	bool BeaconDelta::Serialize( 	RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset ) const
+	{
+		if( 	Serializer::Serialize( buffer, bufferSize, offset, newOffset, BeaconDelta::Type ) &&
+			Serializer::Serialize( buffer, bufferSize, newOffset, newOffset, m_source ) &&
+			Serializer::Serialize( buffer, bufferSize, newOffset, newOffset, m_sequence ) &&
+			Serializer::Serialize( buffer, bufferSize, newOffset, newOffset, m_base ) &&
+			Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_slots.size() ) )
+		{
+			RDSize previous = 0;
+
+			for( RDSize i = 0; i < m_slots.size(); i++ )
+			{
+				if( Serializer::SerializeVarint( buffer, bufferSize, newOffset, newOffset, m_slots[ i ] - previous ) == false )
+				{
+					return false;
+				}
+
+				previous = m_slots[ i ];
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	bool BeaconDelta::Deserialize(	const RDUByte8* buffer,
+ 					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset )
+	{
+		RDUByte8 packetType;
+		
+		if( Serializer::Deserialize( buffer, bufferSize, offset, newOffset, packetType ) )
+		{
+			if( packetType == BeaconDelta::Type )
+			{
+				RDSize count;
+
+				if( 	Serializer::Deserialize( buffer, bufferSize, newOffset, newOffset, m_source ) &&
+					Serializer::Deserialize( buffer, bufferSize, newOffset, newOffset, m_sequence ) &&
+					Serializer::Deserialize( buffer, bufferSize, newOffset, newOffset, m_base ) &&
+					Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, count ) )
+				{
+					// Every slot takes at least a byte, which bounds the count by what remains
+					if( count > bufferSize - newOffset )
+					{
+						RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Beacon Delta Slot Count exceeds Packet" );
+						return false;
+					}
+
+					m_slots.resize( static_cast<size_t>( count ) );
+
+					for( RDSize i = 0, slot = 0; i < count; i++ )
+					{
+						RDSize gap;
+
+						if( Serializer::DeserializeVarint( buffer, bufferSize, newOffset, newOffset, gap ) == false )
+						{
+							RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Failed to Deserialize Beacon Delta Slots" );
+							return false;
+						}
+
+						slot += gap;
+						m_slots[ i ] = slot;
+					}
+
+					return true;
+				}
+				else
+				{
+					RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Failed to Deserialize Beacon Delta Header" );
+				}
+			}
+			else
+			{
+				RD_ERROR( RD_SDRP_ERROR_PACKET_TYPE, "Beacon Delta Deserialized Incorrect Packet Type" );
+			}
+		}
+		else
+		{
+			RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Failed to Deserialize Beacon Delta" );
+		}
+	
+		return false;
+	}
+} }
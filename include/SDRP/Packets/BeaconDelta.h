@@ -0,0 +1,111 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_BEACON_DELTA_H
+#define RD_SDRP_BEACON_DELTA_H
+
+#include <SDRP/Core/Core.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	Beacon packet describing a node's neighbours as the slots changed since its last full
+	 *	beacon. The full beacon's neighbour filter is identified by its digest, and deltas against
+	 *	the same full beacon are numbered from one so that late arrivals may be discarded.
+	 */
+	class BeaconDelta: public ISerializable
+	{
+	public:
+	
+		/// Beacon Delta Packet Type Identifier
+		static const RDUByte8 Type;
+	
+		/**
+		 *	Default Constructor
+		 */
+		BeaconDelta();
+		
+		/**
+		 *	Initializing Constructor
+		 * @param source	Source Node Address
+		 * @param sequence	Number of deltas sent since the full beacon, including this one
+		 * @param base		Digest of the neighbour filter sent in the full beacon
+		 * @param slots		Slots changed since the full beacon, in ascending order
+		 */
+		BeaconDelta( 	const RDNetworkAddress source,
+				const RDUInt16 sequence,
+				const RDSize base,
+				const std::vector<RDSize>& slots );
+		
+		/**
+		 *	Get this beacon's source node address
+		 * @return	Source Node Address
+		 */
+		const RDNetworkAddress Source() const;
+
+		/**
+		 *	Get the number of deltas sent since the full beacon, including this one
+		 * @return	Sequence Number
+		 */
+		const RDUInt16 Sequence() const;
+
+		/**
+		 *	Get the digest of the neighbour filter this delta applies to
+		 * @return	Base Filter Digest
+		 */
+		const RDSize Base() const;
+
+		/**
+		 *	Get the slots changed since the full beacon
+		 * @return	Changed Slot Indices, in ascending order
+		 */
+		const std::vector<RDSize>& Slots() const;
+		
+		/**
+		 *	Serialize this object into the provided data buffer. Slots are written as a varint
+		 *	count followed by varint gaps between successive slots.
+		 * @param buffer	Data buffer into which the object should be serialized
+		 * @param bufferSize	Size of the data buffer in bytes
+		 * @param offset	Offset into the buffer at which serialization should begin
+		 * @param newOffset	New offset produced by serialization
+		 * @return		True - If serialization was successful. False otherwise.
+		 */
+		virtual bool Serialize( 	RDUByte8* buffer,
+						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset ) const;
+			
+		/**
+		 *	Deserialize the this object from the provided data buffer
+		 * @param buffer	Data buffer from which the object should be deserialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which deserialization should begin
+		 * @param newOffset	New offset produced by deserializing the object
+		 * @return		True - If deserialization was successful. False otherwise.
+		 */
+		virtual bool Deserialize( 	const RDUByte8* buffer,
+		 				const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset );
+	
+	private:
+	
+		/// Source Node Address
+		RDNetworkAddress	m_source;
+		/// Deltas sent since the Full Beacon
+		RDUInt16		m_sequence;
+		/// Digest of the Full Beacon's Neighbour Filter
+		RDSize			m_base;
+		/// Changed Slots
+		std::vector<RDSize>	m_slots;
+	};
+} }
+
+#endif // RD_SDRP_BEACON_DELTA_H
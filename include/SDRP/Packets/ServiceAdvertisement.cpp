@@ -65,6 +65,21 @@ namespace Radicle { namespace SDRP
 		m_services = var;
 	}
 
+	const BloomFilterView& ServiceAdvertisement::DestinationsView() const
+	{
+		return m_destinationsView;
+	}
+
+	const BloomFilterView& ServiceAdvertisement::NeighboursView() const
+	{
+		return m_neighboursView;
+	}
+
+	const BloomFilterView& ServiceAdvertisement::ServicesView() const
+	{
+		return m_servicesView;
+	}
+
 	const BloomFilter& ServiceAdvertisement::Neighbours() const
 	{
 		return m_neighbours;
@@ -152,5 +167,33 @@ namespace Radicle { namespace SDRP
 	
 		return false;
 	}
+
+	bool ServiceAdvertisement::Inspect(	const RDUByte8* buffer,
+ 						const RDSize bufferSize,
+						const RDSize offset,
+						RDSize& newOffset )
+	{
+		RDUByte8 packetType;
+		
+		if( Serializer::Deserialize( buffer, bufferSize, offset, newOffset, packetType ) )
+		{
+			if( packetType == ServiceAdvertisement::Type )
+			{
+				return	Serializer::Deserialize( 	buffer, bufferSize, newOffset, newOffset, m_source ) &&
+					m_destinationsView.Deserialize( buffer, bufferSize, newOffset, newOffset ) &&
+					m_neighboursView.Deserialize( 	buffer, bufferSize, newOffset, newOffset ) &&
+					m_servicesView.Deserialize( 	buffer, bufferSize, newOffset, newOffset ) &&
+					Serializer::Deserialize( 	buffer, bufferSize, newOffset, newOffset, m_sequence ) &&
+					Serializer::Deserialize( 	buffer, bufferSize, newOffset, newOffset, m_hops ) &&
+					Serializer::Deserialize(	buffer, bufferSize, newOffset, newOffset, m_maxTTL ); 
+			}
+			else
+			{
+				RD_ERROR( RD_SDRP_ERROR_PACKET_TYPE, "Service Advertisement Inspected Incorrect Packet Type" );
+			}
+		}
+	
+		return false;
+	}
 } }
 
@@ -89,6 +89,24 @@ namespace Radicle { namespace SDRP
 		 * @param	services	services advertiseed by this packet 
 		 */
 		void Services( const BloomFilter& services );
+
+		/**
+		 *	Get a view of the destination nodes of an inspected advertisement
+		 * @return	Destination Nodes View
+		 */
+		const BloomFilterView& DestinationsView() const;
+
+		/**
+		 *	Get a view of the neighbour nodes of an inspected advertisement
+		 * @return	Neighbour Nodes View
+		 */
+		const BloomFilterView& NeighboursView() const;
+
+		/**
+		 *	Get a view of the services advertised by an inspected advertisement
+		 * @return	Advertised Services View
+		 */
+		const BloomFilterView& ServicesView() const;
 		
 		/**
 		 *	Get the packet sequence number
@@ -156,6 +174,20 @@ namespace Radicle { namespace SDRP
 		 				const RDSize bufferSize,
 						const RDSize offset,
 						RDSize& newOffset );
+
+		/**
+		 *	Deserialize the fields of this advertisement from the provided data buffer, attaching views
+		 *	to its filters rather than deserializing them. The views remain valid only while the buffer does.
+		 * @param buffer	Data buffer from which the object should be inspected
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which inspection should begin
+		 * @param newOffset	New offset produced by inspecting the object
+		 * @return		True - If inspection was successful. False otherwise.
+		 */
+		bool Inspect( 	const RDUByte8* buffer,
+				const RDSize bufferSize,
+				const RDSize offset,
+				RDSize& newOffset );
 	
 	private:
 	
@@ -167,6 +199,12 @@ namespace Radicle { namespace SDRP
 		BloomFilter 		m_neighbours;
 		/// Advertised Services
 		BloomFilter		m_services;
+		/// Destination Nodes View
+		BloomFilterView		m_destinationsView;
+		/// Neighbour Nodes View
+		BloomFilterView		m_neighboursView;
+		/// Advertised Services View
+		BloomFilterView		m_servicesView;
 		/// Packet Sequence Number
 		RDUInt32		m_sequence;
 		/// Number of hops traversed by packet
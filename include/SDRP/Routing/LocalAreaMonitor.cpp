@@ -17,7 +17,10 @@ namespace Radicle { namespace SDRP
 	LocalAreaMonitor::LocalAreaMonitor( const Node& localNode ) : 	m_maxAge( LocalAreaMonitor::DefaultMaxAge ),
 									m_cacheIsValid( false ),
 									m_mode( MPRFactory::MPR ),
-									m_calculatorFactory( localNode )
+									m_calculatorFactory( localNode ),
+									m_neighbourSet( 	BloomFilter::PredictedElementCount,
+												ScalableBloomFilter::RateForFirstLayer( BloomFilter::DesiredFalsePositiveRate ),
+												BloomFilter::MembershipLayout )
 	{
 		m_calculator = m_calculatorFactory.GetCalculator( m_mode );
 	}
@@ -45,7 +48,41 @@ namespace Radicle { namespace SDRP
 
 	const BloomFilter& LocalAreaMonitor::NeighbourFilter( bool constrain, const RDSize size )
 	{
-		return m_neighbourFilter;
+		if( constrain )
+		{
+			RebuildNeighbourFilter( size > m_neighbours.size() ? size : m_neighbours.size() );
+		}
+		else if( m_neighbourSet.LayerCount() > 1 )
+		{
+			// Receivers expect a single filter, so a set which has grown is consolidated first
+			RebuildNeighbourFilter();
+		}
+
+		return m_neighbourSet.Layer( 0 );
+	}
+
+	const LocalAreaMonitor::NodeContainer& LocalAreaMonitor::Neighbours() const
+	{
+		return m_neighbours;
+	}
+
+	RDSize LocalAreaMonitor::ExpectedNeighbourCount() const
+	{
+		RDDouble advertised = 0.0;
+		RDSize advertisers = 0;
+
+		for( NodeContainer::const_iterator i = m_neighbours.begin(); i != m_neighbours.end(); i++ )
+		{
+			if( i->Neighbours().TableSize() > 0 )
+			{
+				advertised += i->Neighbours().EstimateCardinality();
+				advertisers++;
+			}
+		}
+
+		RDSize expected = advertisers > 0 ? static_cast<RDSize>( advertised / advertisers + 0.5 ) : 0;
+
+		return expected > m_neighbours.size() ? expected : m_neighbours.size();
 	}
 
 	void LocalAreaMonitor::Mode( MPRFactory::MPRSelectionMode mode )
@@ -72,19 +109,27 @@ namespace Radicle { namespace SDRP
 
 	void LocalAreaMonitor::RebuildNeighbourFilter()
 	{
+		RebuildNeighbourFilter( m_neighbours.size() > 0 ? m_neighbours.size() * 2 : BloomFilter::PredictedElementCount );
+	}
+
+	void LocalAreaMonitor::RebuildNeighbourFilter( const RDSize capacity )
+	{
+		m_neighbourSet.Reset( capacity );
 
 		if( m_neighbours.size() == 0 )
 		{
-			m_neighbourFilter = BloomFilter::Empty;
 			return;
 		}
 
-		m_neighbourFilter.ResetWithParameters( m_neighbours.size() );
+		std::vector<RDIdentifier> addresses;
+		addresses.reserve( m_neighbours.size() );
 
 		for( NodeContainer::iterator i = m_neighbours.begin(); i != m_neighbours.end(); i++ )
 		{
-			m_neighbourFilter.Insert( i->Address() );
+			addresses.push_back( i->Address() );
 		}
+
+		m_neighbourSet.InsertMany( &addresses[ 0 ], addresses.size() );
 	}
 
 	void LocalAreaMonitor::NodeWasSeen( const Node& node )
@@ -93,34 +138,70 @@ namespace Radicle { namespace SDRP
 
 		if( result.second == true )
 		{
+			m_neighbourSet.Insert( node.Address() );
+
 			for( SubscriberContainer::iterator i = Subscribers().begin(); i != Subscribers().end(); i++ )
 			{
-				m_neighbourFilter.Insert( node.Address() );
 				( *i )->OnNeighbourAdded( node );
 			}
 		}
 
-		try
-		{
-			if( result.second == true || result.first->Neighbours() != node.Neighbours() )
-			{
-				m_cacheIsValid = false;
-				RebuildNeighbourFilter();
-			}
-		}
-		catch( BloomFilterSizeMismatchException e )
+		// Only the MPR selection depends on a neighbour's own neighbours
+		if( 	result.second == true || result.first->Neighbours().Foldable( node.Neighbours() ) == false ||
+			result.first->Neighbours() != node.Neighbours() )
 		{
 			m_cacheIsValid = false;
 		}
-		
 
 		m_neighbours.erase( result.first );
 		result = m_neighbours.insert( node );
 	}
 
+	void LocalAreaMonitor::KeyframeWasSeen( const Node& node )
+	{
+		m_keyframes[ node.Address() ] = std::make_pair( node.Neighbours(), static_cast<RDUInt16>( 0 ) );
+		NodeWasSeen( node );
+	}
+
+	bool LocalAreaMonitor::DeltaWasSeen( 	const RDNetworkAddress address,
+						const RDSize base,
+						const RDUInt16 sequence,
+						const std::vector<RDSize>& slots,
+						const RDTimeStamp lastSeen )
+	{
+		std::map< RDNetworkAddress, std::pair<BloomFilter, RDUInt16> >::iterator keyframe = m_keyframes.find( address );
+
+		if( keyframe != m_keyframes.end() && keyframe->second.first.Digest() == base && sequence > keyframe->second.second )
+		{
+			BloomFilter neighbours( keyframe->second.first );
+			neighbours.Flip( slots );
+			keyframe->second.second = sequence;
+
+			NodeWasSeen( Node( address, BloomFilter(), neighbours, lastSeen ) );
+			return true;
+		}
+
+		// The node is still present even though its neighbours cannot be brought up to date
+		Node seen;
+		seen.Address( address );
+
+		NodeContainer::iterator known = m_neighbours.find( seen );
+
+		if( known != m_neighbours.end() )
+		{
+			seen = ( *known );
+			seen.LastSeen( lastSeen );
+			m_neighbours.erase( known );
+			m_neighbours.insert( seen );
+		}
+
+		return false;
+	}
+
 	void LocalAreaMonitor::Purge()
 	{
 		RDTimeStamp now = Logger::Time();
+		bool purged = false;
 
 		for( NodeContainer::iterator i = m_neighbours.begin(); i != m_neighbours.end();  )
 		{
@@ -131,8 +212,10 @@ namespace Radicle { namespace SDRP
 					( *j )->OnNeighbourLost( ( *i ) );
 				}
 
+				m_keyframes.erase( i->Address() );
 				m_neighbours.erase( i++ );
 				m_cacheIsValid = false;
+				purged = true;
 			}
 			else
 			{
@@ -140,6 +223,10 @@ namespace Radicle { namespace SDRP
 			}
 		}
 
-		RebuildNeighbourFilter();
+		// Elements cannot be removed from the neighbour set, so it is rebuilt only after a loss
+		if( purged )
+		{
+			RebuildNeighbourFilter();
+		}
 	}
 }}
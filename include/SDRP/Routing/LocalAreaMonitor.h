@@ -74,10 +74,26 @@ namespace Radicle { namespace SDRP
 		/**
 		 *	Get a bloom filter describing this node's neighbours
 		 * @param constrain 	Indicates whether the bloom filter should be constrained to a certain size
-		 * @param size 		Constraint Size
+		 * @param size 		Constraint Size, as a number of neighbours. The filter is never sized
+		 *			for fewer neighbours than are currently known.
 		 */
 		const BloomFilter& NeighbourFilter( bool constrain = false, const RDSize size = 0 );
 
+		/**
+		 *	Get the neighbours currently known
+		 * @return	Neighbour Nodes
+		 */
+		const NodeContainer& Neighbours() const;
+
+		/**
+		 *	Estimate the number of neighbours filters describing this node's neighbourhood should be
+		 *	sized for. Neighbouring nodes usually see neighbourhoods of a similar size, so this is the
+		 *	larger of the neighbours seen and the mean estimated cardinality of the neighbour filters
+		 *	they advertise.
+		 * @return 	Expected Neighbour Count
+		 */
+		RDSize ExpectedNeighbourCount() const;
+
 		/**
 		 *	Set the maximum neighbour age. This will determine when neighbours are purged
 		 *	due to inactivity
@@ -98,6 +114,31 @@ namespace Radicle { namespace SDRP
 		 */
 		void NodeWasSeen( const Node& node );
 
+		/**
+		 *	A node was seen in the local area through a full beacon. The node's neighbour filter
+		 *	is kept as the base for later beacon deltas from the node.
+		 * @param node 	Seen Node
+		 */
+		void KeyframeWasSeen( const Node& node );
+
+		/**
+		 *	A node was seen in the local area through a beacon delta. The node's neighbour filter
+		 *	is reconstructed from its last full beacon if that is the delta's base, and the delta
+		 *	is newer than any already applied to it. Otherwise only the time the node was last
+		 *	seen is updated, and its neighbour filter resynchronizes on its next full beacon.
+		 * @param address 	Node Network Address
+		 * @param base		Digest of the neighbour filter the delta applies to
+		 * @param sequence	Number of deltas sent since the full beacon, including this one
+		 * @param slots		Slots changed since the full beacon
+		 * @param lastSeen	Time at which the delta was received
+		 * @return		True - If the node's neighbour filter was reconstructed. False otherwise.
+		 */
+		bool DeltaWasSeen( 	const RDNetworkAddress address,
+					const RDSize base,
+					const RDUInt16 sequence,
+					const std::vector<RDSize>& slots,
+					const RDTimeStamp lastSeen );
+
 		/**
 		 *	Purge any neighbour that hasn't been seen recently
 		 */
@@ -106,11 +147,19 @@ namespace Radicle { namespace SDRP
 	protected:
 
 		/**
-		 *
-		 * @return 	Bloom Filter containing all neighbour addresses
+		 *	Rebuild the neighbour set from the current neighbours as a single layer with room
+		 *	for as many again, such that layers are only added and consolidated as the
+		 *	neighbourhood doubles in size
 		 */
 		void RebuildNeighbourFilter();
 
+		/**
+		 *	Rebuild the neighbour set from the current neighbours as a single layer of the given capacity
+		 * @param capacity 	Number of neighbours the set should be sized for. At least the
+		 *			number of current neighbours.
+		 */
+		void RebuildNeighbourFilter( const RDSize capacity );
+
 		/// MPR Selection Mode
 		MPRFactory::MPRSelectionMode	m_mode;
 		/// MPR Calculator Factory
@@ -125,8 +174,10 @@ namespace Radicle { namespace SDRP
 		bool 				m_cacheIsValid;
 		/// Cached MPR Filter
 		BloomFilter 			m_mpr;
-		/// Neighbour Filter
-		BloomFilter			m_neighbourFilter;
+		/// Neighbour Set. Only its first layer is sent, so that layer is held to the configured rate.
+		ScalableBloomFilter		m_neighbourSet;
+		/// Neighbour filter of each neighbour's last full beacon, and the last delta applied to it
+		std::map< RDNetworkAddress, std::pair<BloomFilter, RDUInt16> >	m_keyframes;
 	};
 }}
 
@@ -49,7 +49,7 @@ namespace Radicle { namespace SDRP {
 		// Generate Bloom Filter for required neighbour coverage
 		for( NodeContainer::const_iterator i = neighbours.begin(); i != neighbours.end(); i++ )
 		{
-			requiredCoverage = requiredCoverage.Union( i->Neighbours() );
+			requiredCoverage |= i->Neighbours();
 		}
 
 		NeighbourSortComparator comparator( neighbourFilter );
@@ -59,12 +59,12 @@ namespace Radicle { namespace SDRP {
 		for( NodeContainer::const_iterator i = neighbours.begin(); i != neighbours.end(); i++ )
 		{
 			Node n( *i );
-			n.Neighbours().Remove( neighbourFilter );
+			n.Neighbours().SubtractWith( neighbourFilter );
 
 			if( requiredCoverage.RemovalResultsInDifference( n.Neighbours() ) )
 			{
 				mprAddresses.insert( n.Address() );
-				coverage = coverage.Union( n.Neighbours() );
+				coverage |= n.Neighbours();
 			}
 			else
 			{
@@ -74,22 +74,24 @@ namespace Radicle { namespace SDRP {
 
 		// Add nodes in order of coverage area
 		for( 	std::set<Node, NeighbourSortComparator>::const_iterator i = sizeSet.begin(); 
-			i != sizeSet.end() && coverage.Difference( requiredCoverage ) > 0; i++ )
+			i != sizeSet.end() && coverage.XorCount( requiredCoverage ) > 0; i++ )
 		{
 			if( coverage.Contains( i->Neighbours() ) == false )
 			{
-				coverage = coverage.Union( i->Neighbours() );
+				coverage |= i->Neighbours();
 				mprAddresses.insert( i->Address() );
 			}
 		}
 
 		// Create an MPR Filter 
-		BloomFilter mprNodes( mprAddresses.size() * 2, BloomFilter::DesiredFalsePositiveRate );
+		BloomFilter mprNodes( mprAddresses.size() * 2, BloomFilter::DesiredFalsePositiveRate, BloomFilter::MembershipLayout );
 
 		// Insert MPR Node Addresses
-		for( std::set<RDNetworkAddress>::const_iterator i = mprAddresses.begin(); i != mprAddresses.end(); i++ )
+		std::vector<RDIdentifier> addresses( mprAddresses.begin(), mprAddresses.end() );
+
+		if( addresses.empty() == false )
 		{
-			mprNodes.Insert( ( *i ) );
+			mprNodes.InsertMany( &addresses[ 0 ], addresses.size() );
 		}
 
 		return mprNodes;
@@ -57,38 +57,131 @@ namespace Radicle { namespace SDRP {
 		return !( ( *this ) == other );
 	}
 
+	const RDSize ReducedMPRCalculator::SketchedNodeCount = 64;
+
 	IMPRCalculator::NodeContainer ReducedMPRCalculator::EliminateSimilarNodes( 	const IMPRCalculator::NodeContainer& input, 
-											float minimumDifference )
+											float minimumSimilarity )
 	{
-		NodeContainer container( input );
+		std::vector<NodeContainer::const_iterator> nodes;
 
-		for( NodeContainer::iterator i = container.begin(); i != container.end(); )
+		for( NodeContainer::const_iterator i = input.begin(); i != input.end(); i++ )
 		{
-			NodeContainer::iterator start( i );
-			start++;
+			if( i->Neighbours().TableSize() > 0 )
+			{
+				nodes.push_back( i );
+			}
+		}
+
+		// Later nodes which may be similar to each node
+		std::vector< std::set<RDSize> > candidates( nodes.size() );
 
-			if( i->Neighbours().TableSize() == 0 )
+		if( nodes.size() < SketchedNodeCount )
+		{
+			for( RDSize i = 0; i < nodes.size(); i++ )
 			{
-				container.erase( i++ );
-				continue;
+				for( RDSize j = i + 1; j < nodes.size(); j++ )
+				{
+					candidates[ i ].insert( j );
+				}
 			}
+		}
+		else
+		{
+			// One filter of each geometry present stands for the rest
+			std::vector<const BloomFilter*> geometries;
 
-			for( NodeContainer::iterator j = start; j != container.end(); )
+			for( RDSize i = 0; i < nodes.size(); i++ )
 			{
-				if( i->Neighbours().TableSize() == j->Neighbours().TableSize() )
+				const BloomFilter& filter = nodes[ i ]->Neighbours();
+				bool known = false;
+
+				for( RDSize g = 0; g < geometries.size() && known == false; g++ )
 				{
-					double difference = i->Neighbours().SetDifference( j->Neighbours() );
+					known = 	geometries[ g ]->TableSize() == filter.TableSize() && geometries[ g ]->Layout() == filter.Layout() &&
+							geometries[ g ]->Hashing() == filter.Hashing() && geometries[ g ]->Reduction() == filter.Reduction();
+				}
 
-					if( difference / i->Neighbours().TableSize() < minimumDifference )
+				if( known == false )
+				{
+					geometries.push_back( &filter );
+				}
+			}
+
+			// Filters are sketched at the smallest size they fold to, as they would be compared
+			// below SketchedNodeCount, so that filters of different sizes may share bands
+			std::vector<MinHashSketch> sketches( nodes.size() );
+
+			for( RDSize i = 0; i < nodes.size(); i++ )
+			{
+				const BloomFilter& filter = nodes[ i ]->Neighbours();
+				RDSize smallest = filter.TableSize();
+
+				for( RDSize g = 0; g < geometries.size(); g++ )
+				{
+					if( geometries[ g ]->TableSize() < smallest && filter.Foldable( *geometries[ g ] ) )
 					{
-						container.erase( j++ );
-						continue;
+						smallest = geometries[ g ]->TableSize();
 					}
 				}
-				j++;
+
+				if( smallest == filter.TableSize() )
+				{
+					sketches[ i ] = nodes[ i ]->NeighbourSketch();
+				}
+				else
+				{
+					BloomFilter folded( filter );
+					sketches[ i ] = MinHashSketch( folded.Fold( smallest ) );
+				}
+			}
+
+			// Nodes sharing any band of their neighbour sketches are likely similar, so only
+			// they are compared
+			for( RDSize band = 0; band < sketches[ 0 ].BandCount(); band++ )
+			{
+				std::map< RDUInt32, std::vector<RDSize> > buckets;
+
+				for( RDSize i = 0; i < nodes.size(); i++ )
+				{
+					buckets[ sketches[ i ].Band( band ) ].push_back( i );
+				}
+
+				for( std::map< RDUInt32, std::vector<RDSize> >::const_iterator bucket = buckets.begin(); bucket != buckets.end(); bucket++ )
+				{
+					for( RDSize i = 0; i < bucket->second.size(); i++ )
+					{
+						for( RDSize j = i + 1; j < bucket->second.size(); j++ )
+						{
+							candidates[ bucket->second[ i ] ].insert( bucket->second[ j ] );
+						}
+					}
+				}
+			}
+		}
+
+		std::vector<bool> eliminated( nodes.size(), false );
+		NodeContainer container;
+
+		for( RDSize i = 0; i < nodes.size(); i++ )
+		{
+			if( eliminated[ i ] )
+			{
+				continue;
+			}
+
+			const BloomFilter& neighbours = nodes[ i ]->Neighbours();
+
+			for( std::set<RDSize>::const_iterator j = candidates[ i ].begin(); j != candidates[ i ].end(); j++ )
+			{
+				// Filters of different sizes are compared at the smaller size
+				if( 	eliminated[ *j ] == false && neighbours.Foldable( nodes[ *j ]->Neighbours() ) &&
+					neighbours.Similarity( nodes[ *j ]->Neighbours() ) > minimumSimilarity )
+				{
+					eliminated[ *j ] = true;
+				}
 			}
 
-			i++;
+			container.insert( container.end(), *nodes[ i ] );
 		}
 
 		return container;
@@ -133,9 +226,10 @@ namespace Radicle { namespace SDRP {
 	{
 		// Create a set of nodes which can be sorted by degree of difference w.r.t neighbour filters
 		std::set<RMPRContainer> differenceSet;
-		BloomFilter mprNodes;
+		// Destinations are drawn from the neighbours, so the filter never needs room for more
+		BloomFilter mprNodes( neighbours.size() > 0 ? neighbours.size() : 1, BloomFilter::DesiredFalsePositiveRate, BloomFilter::MembershipLayout );
 
-		NodeContainer reduced = EliminateSimilarNodes( neighbours, 0.05 );
+		NodeContainer reduced = EliminateSimilarNodes( neighbours, 0.75 );
 
 		// Fill the set
 		for( NodeContainer::const_iterator i = reduced.begin(); i != reduced.end(); i++ )
@@ -145,8 +239,9 @@ namespace Radicle { namespace SDRP {
 				BloomFilter neighbourFilter( i->Neighbours() );
 				RMPRContainer neighbourDescription( ( *i ) );
 
-				// Create comparison filter
-				BloomFilter myNeighbours( neighbourFilter.TableSize(), neighbourFilter.HashCount() );
+				// Create comparison filter sharing the neighbour filter's geometry and hashing
+				BloomFilter myNeighbours( neighbourFilter );
+				myNeighbours.Clear();
 
 				myNeighbours.Insert( m_localNode.Address() );
 
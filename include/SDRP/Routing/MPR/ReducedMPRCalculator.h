@@ -89,16 +89,19 @@ namespace Radicle { namespace SDRP {
 			float 		m_difference;
 		};
 
+		/// Number of nodes from which only nodes with matching neighbour sketch bands are compared
+		const static RDSize SketchedNodeCount;
+
 		/**
-		 *	Iterate over the node container and find nodes with matching neighbour filter sizes, then
-		 *	compare them in terms of the differences between the filters, eliminating nodes with
-		 *	filter which don't have significant differences.
+		 *	Iterate over the node container and compare nodes in terms of the estimated Jaccard
+		 *	similarity of their neighbour filters, eliminating nodes with filters too similar to those
+		 *	of nodes already kept. Nodes without a neighbour filter are eliminated. From
+		 *	SketchedNodeCount nodes, only nodes sharing a band of their neighbour sketches are
+		 *	compared, so the odd similar pair may be missed.
 		 * @param container 		Node Container
-		 * @param minimumDifference 	Minimum difference expressed as a floating point number quantified as
-		 *				the ratio of the number of differently set bits in the two filters to
-		 *				the size of the filters being compared.
+		 * @param minimumSimilarity 	Similarity above which a node is eliminated, between 0 and 1
 		 */
-		static NodeContainer EliminateSimilarNodes( const NodeContainer& container, const float minimumDifference );
+		static NodeContainer EliminateSimilarNodes( const NodeContainer& container, const float minimumSimilarity );
 
 		static float Mean( const std::set<RMPRContainer>& differenceSet );
 
@@ -73,11 +73,18 @@ namespace Radicle { namespace SDRP
 	BloomFilter NeighbourList::Neighbours( const RDSize count ) const
 	{
 		BloomFilter neighbours( count, BloomFilter::DesiredFalsePositiveRate );
+		std::vector<RDIdentifier> addresses;
+		addresses.reserve( m_neighbours.size() );
 		
 		for( 	std::vector< std::pair<RDTimeStamp, Node> >::const_iterator i = m_neighbours.begin();
 			i != m_neighbours.end(); ++i )
 		{
-			neighbours.Insert( i->second.Address() );
+			addresses.push_back( i->second.Address() );
+		}
+
+		if( addresses.empty() == false )
+		{
+			neighbours.InsertMany( &addresses[ 0 ], addresses.size() );
 		}
 		
 		return neighbours;
@@ -92,7 +99,7 @@ namespace Radicle { namespace SDRP
 		for( 	std::vector< std::pair<RDTimeStamp, Node> >::const_iterator i = m_neighbours.begin();
 			i != m_neighbours.end(); ++i )
 		{
-			u = u.Union( i->second.Neighbours() );
+			u |= i->second.Neighbours();
 			neighbours.insert( i->second.Neighbours() );
 		}
 		
@@ -107,20 +114,20 @@ namespace Radicle { namespace SDRP
 		for( std::set<BloomFilter>::const_iterator i = mprs.begin(); i != mprs.end(); ++i )
 		{
 			neighbours.erase( ( *i ) );
-			filter = filter.Union( ( *i ) );
+			filter |= ( *i );
 		}
 		
 		for( std::set<BloomFilter>::reverse_iterator i = neighbours.rbegin(); i != neighbours.rend(); ++i )
 		{
-			if( u.Difference( filter ) == 0 )
+			if( u.XorCount( filter ) == 0 )
 			{
 				break;
 			}
 			
-			if( filter.Difference( ( *i ) ) != 0 && filter.Contains( ( *i ) ) == false )
+			if( filter.XorCount( ( *i ) ) != 0 && filter.Contains( ( *i ) ) == false )
 			{
 				mprs.insert( ( *i ) );
-				filter = filter.Union( ( *i ) );
+				filter |= ( *i );
 			}
 		}
 		
@@ -129,20 +136,27 @@ namespace Radicle { namespace SDRP
 			if( filter.RemovalResultsInDifference( *i ) == false )
 			{
 				mprs.erase( ( *i ) );
-				filter.Remove( ( *i ) );
+				filter.SubtractWith( ( *i ) );
 			}
 		}
 		
+		// Map filters back to the first neighbour advertising each
+		std::map<RDSize, const Node*> advertisers;
+
+		for( 	std::vector< std::pair< RDTimeStamp, Node > >::const_iterator j = m_neighbours.begin();
+			j != m_neighbours.end(); ++j )
+		{
+			advertisers.insert( std::make_pair( j->second.Neighbours().Digest(), &j->second ) );
+		}
+
 		for( std::set<BloomFilter>::const_iterator i = mprs.begin(); i != mprs.end(); ++i )
 		{
-			for( 	std::vector< std::pair< RDTimeStamp, Node > >::const_iterator j = m_neighbours.begin();
-				j != m_neighbours.end(); ++j )
+			std::map<RDSize, const Node*>::const_iterator advertiser = advertisers.find( i->Digest() );
+
+			// Digests may collide, so the advertised filter is confirmed
+			if( advertiser != advertisers.end() && advertiser->second->Neighbours() == ( *i ) )
 			{
-				if( ( *i ) == j->second.Neighbours() )
-				{
-					mprNodes.insert( j->second );
-					break;
-				}
+				mprNodes.insert( *advertiser->second );
 			}
 		}
 		
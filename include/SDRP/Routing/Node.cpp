@@ -14,16 +14,34 @@ namespace Radicle { namespace SDRP
 {
 	Node::Node() :
 	m_address( RD_SDRP_UNSPECIFIED_ADDRESS ),
-	m_services( 5, 0.1 )
+	m_services( 5, 0.1, BloomFilter::MembershipLayout ),
+	m_sketched( false )
 	{}
 	
 	Node::Node( const Node& other ) :
 	m_address( other.m_address ),
 	m_services( other.m_services ),
 	m_neighbours( other.m_neighbours ),
-	m_lastSeen( other.m_lastSeen )
+	m_lastSeen( other.m_lastSeen ),
+	m_sketch( other.m_sketch ),
+	m_sketched( other.m_sketched )
 	{}
 
+	Node& Node::operator=( const Node& other )
+	{
+		if( this != &other )
+		{
+			m_address = other.m_address;
+			m_services = other.m_services;
+			m_neighbours = other.m_neighbours;
+			m_lastSeen = other.m_lastSeen;
+			m_sketch = other.m_sketch;
+			m_sketched = other.m_sketched;
+		}
+
+		return ( *this );
+	}
+
 	Node::Node(	const RDNetworkAddress address,
 			const BloomFilter& services,
 			const BloomFilter& neighbours,
@@ -31,7 +49,8 @@ namespace Radicle { namespace SDRP
 	m_address( address ),
 	m_services( services ),
 	m_neighbours( neighbours ),
-	m_lastSeen( lastSeen )
+	m_lastSeen( lastSeen ),
+	m_sketched( false )
 	{}
 	
 	const RDNetworkAddress Node::Address() const
@@ -66,12 +85,25 @@ namespace Radicle { namespace SDRP
 	
 	BloomFilter& Node::Neighbours()
 	{
+		m_sketched = false;
 		return m_neighbours;
 	}
 
 	void Node::Neighbours( const BloomFilter& neighbours )
 	{
 		m_neighbours = neighbours;
+		m_sketched = false;
+	}
+
+	const MinHashSketch& Node::NeighbourSketch() const
+	{
+		if( m_sketched == false )
+		{
+			m_sketch = MinHashSketch( m_neighbours );
+			m_sketched = true;
+		}
+
+		return m_sketch;
 	}
 
 	RDTimeStamp Node::LastSeen() const
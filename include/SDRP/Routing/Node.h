@@ -33,6 +33,12 @@ namespace Radicle { namespace SDRP
 		 */
 		Node( const Node& other );
 
+		/**
+		 *	Assignment Operator. Assign this node the data of other.
+		 * @param other 	Node from which to assign data
+		 */
+		Node& operator=( const Node& other );
+
 		/**
 		 *	Initializing Constructor
 		 * @param address	Node Network Address
@@ -93,6 +99,14 @@ namespace Radicle { namespace SDRP
 		 */
 		void Neighbours( const BloomFilter& neighbours );
 
+		/**
+		 *	Get a MinHash sketch of the bloom filter describing the neighbours of this node. The
+		 *	sketch is taken when first requested and kept until the neighbours filter is replaced
+		 *	or made available for modification.
+		 * @return	Neighbours Sketch
+		 */
+		const MinHashSketch& NeighbourSketch() const;
+
 		/**
 		 *	Get or Set the Node Last Seen Time
 		 */
@@ -116,6 +130,10 @@ namespace Radicle { namespace SDRP
 		BloomFilter		m_services;
 		/// Bloom Filter containing this node's neighbours
 		BloomFilter		m_neighbours;
+		/// Sketch of this node's neighbours, valid while m_sketched is set
+		mutable MinHashSketch	m_sketch;
+		/// Whether m_sketch describes the current neighbours filter
+		mutable bool		m_sketched;
 	};
 } }
 
@@ -17,16 +17,21 @@ namespace Radicle { namespace SDRP
 	
 	void RouteTable::Add( const Route& newRoute )
 	{	
-		for( RouteList::iterator i = m_routes.begin(); i != m_routes.end(); ++i )
+		NextHopRoutes& nextHop = m_nextHops[ newRoute.NextHop() ];
+
+		for( RouteList::iterator i = nextHop.second.begin(); i != nextHop.second.end(); ++i )
 		{
-			if( i->Server() == newRoute.Server() && i->NextHop() == newRoute.NextHop() )
+			if( i->Server() == newRoute.Server() )
 			{
+				// The replaced route's services may no longer be offered
 				( *i ) = newRoute;
+				Aggregate( nextHop );
 				return;
 			}
 		}
 		
-		m_routes.push_back( newRoute );
+		nextHop.second.push_back( newRoute );
+		nextHop.first.Merge( newRoute.Services(), newRoute.Hops() );
 		
 		std::stringstream stream;
 		
@@ -48,27 +53,55 @@ namespace Radicle { namespace SDRP
 	{
 		RDTimeStamp time = Logger::Time();
 	
-		for( 	RouteList::iterator i = m_routes.begin();
-			i != m_routes.end(); )
+		for( NextHopMap::iterator n = m_nextHops.begin(); n != m_nextHops.end(); )
 		{
-			if( ( time - i->Age() ) > maxAge )
+			RouteList& routes = n->second.second;
+			RDSize count = routes.size();
+
+			for( 	RouteList::iterator i = routes.begin();
+				i != routes.end(); )
 			{
-				m_routes.erase( i++ );
+				if( ( time - i->Age() ) > maxAge )
+				{
+					routes.erase( i++ );
+				}
+				else
+				{
+					++i;
+				}
+			}
+
+			if( routes.empty() )
+			{
+				m_nextHops.erase( n++ );
 			}
 			else
 			{
-				++i;
+				if( routes.size() != count )
+				{
+					Aggregate( n->second );
+				}
+
+				++n;
 			}
 		}
 	}
 	
 	bool RouteTable::HasRoutesToService( const RDServiceIdentifier service ) const
 	{
-		for( RouteList::const_iterator i = m_routes.begin(); i != m_routes.end(); ++i )
+		for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
 		{
-			if( i->Services().Contains( service ) )
+			if( n->second.first.Contains( service ) == false )
+			{
+				continue;
+			}
+
+			for( RouteList::const_iterator i = n->second.second.begin(); i != n->second.second.end(); ++i )
 			{
-				return true;
+				if( i->Services().Contains( service ) )
+				{
+					return true;
+				}
 			}
 		}
 		
@@ -79,46 +112,97 @@ namespace Radicle { namespace SDRP
 	{
 		std::set<Route> routes;
 		
-		for( RouteList::const_iterator i = m_routes.begin(); i != m_routes.end(); ++i )
+		for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
 		{
-			if( i->Services().Contains( service ) )
+			if( n->second.first.Contains( service ) == false )
+			{
+				continue;
+			}
+
+			for( RouteList::const_iterator i = n->second.second.begin(); i != n->second.second.end(); ++i )
 			{
-				routes.insert( ( *i ) );
+				if( i->Services().Contains( service ) )
+				{
+					routes.insert( ( *i ) );
+				}
 			}
 		}
 		
 		if( routes.size() == 0 )
 		{
-			RD_NLOG( "Failed to Find Route to Service " << service << " Route Table (" << m_routes.size() << ") Dump Follows" );
-			
-			for( RouteList::const_iterator i = m_routes.begin(); i != m_routes.end(); ++i )
+			RDSize count = 0;
+
+			for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
 			{
-				std::stringstream stream;
-				
-				stream << "Server " << i->Server() << ": ";
+				count += n->second.second.size();
+			}
+
+			RD_NLOG( "Failed to Find Route to Service " << service << " Route Table (" << count << ") Dump Follows" );
 			
-				for( RDServiceIdentifier s = 0; s < 10; s++ )
+			for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
+			{
+				for( RouteList::const_iterator i = n->second.second.begin(); i != n->second.second.end(); ++i )
 				{
-					if( i->Services().Contains( s ) )
+					std::stringstream stream;
+					
+					stream << "Server " << i->Server() << ": ";
+				
+					for( RDServiceIdentifier s = 0; s < 10; s++ )
 					{
-						stream << s << ", ";
+						if( i->Services().Contains( s ) )
+						{
+							stream << s << ", ";
+						}
 					}
+					
+					RD_NLOG( stream.str() );
 				}
-				
-				RD_NLOG( stream.str() );
 			}
 		}
 		
 		return routes;
 	}
+
+	bool RouteTable::NearestNextHop( 	const RDServiceIdentifier service,
+						RDNetworkAddress& nextHop,
+						RDSize& hops ) const
+	{
+		bool found = false;
+
+		for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
+		{
+			RDSize distance;
+
+			if( n->second.first.Nearest( service, distance ) && ( found == false || distance < hops ) )
+			{
+				found = true;
+				nextHop = n->first;
+				hops = distance;
+			}
+		}
+
+		return found;
+	}
+
+	const AttenuatedBloomFilter& RouteTable::ServicesThrough( const RDNetworkAddress nextHop ) const
+	{
+		// Constructed on first use, after the default table allocator
+		static const AttenuatedBloomFilter none;
+
+		NextHopMap::const_iterator n = m_nextHops.find( nextHop );
+		return n != m_nextHops.end() ? n->second.first : none;
+	}
 	
 	bool RouteTable::HasRouteToHost( const RDNetworkAddress address ) const
 	{
-		for( RouteList::const_iterator i = m_routes.begin(); i != m_routes.end(); ++i )
+		for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
 		{
-			if( i->Server() == address )
+			for( RouteList::const_iterator i = n->second.second.begin(); i != n->second.second.end(); ++i )
 			{
-				return true;
+				if( i->Server() == address )
+				{
+					return true;
+				}
 			}
 		}
 		
@@ -129,11 +213,14 @@ namespace Radicle { namespace SDRP
 	{
 		std::set<Route> routes;
 		
-		for( RouteList::const_iterator i = m_routes.begin(); i != m_routes.end(); ++i )
+		for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
 		{
-			if( i->Server() == address )
+			for( RouteList::const_iterator i = n->second.second.begin(); i != n->second.second.end(); ++i )
 			{
-				routes.insert( ( *i ) );
+				if( i->Server() == address )
+				{
+					routes.insert( ( *i ) );
+				}
 			}
 		}
 		
@@ -142,19 +229,29 @@ namespace Radicle { namespace SDRP
 	
 	bool RouteTable::HaveSuperiorRoute( const Route& newRoute ) const
 	{
-		std::set<Route> routes;
-		
-		for( RouteList::const_iterator i = m_routes.begin(); i != m_routes.end(); ++i )
+		for( NextHopMap::const_iterator n = m_nextHops.begin(); n != m_nextHops.end(); ++n )
 		{
-			if( 	i->Server() != newRoute.Server() && 
-				i->Services().Contains( newRoute.Services() ) &&
-				i->Hops() < newRoute.Hops() )
+			for( RouteList::const_iterator i = n->second.second.begin(); i != n->second.second.end(); ++i )
 			{
-				return true;
+				if( 	i->Server() != newRoute.Server() && 
+					i->Services().Contains( newRoute.Services() ) &&
+					i->Hops() < newRoute.Hops() )
+				{
+					return true;
+				}
 			}
 		}
 		
 		return false;
 	}
-} }
 
+	void RouteTable::Aggregate( NextHopRoutes& routes )
+	{
+		routes.first.Clear();
+
+		for( RouteList::const_iterator i = routes.second.begin(); i != routes.second.end(); ++i )
+		{
+			routes.first.Merge( i->Services(), i->Hops() );
+		}
+	}
+} }
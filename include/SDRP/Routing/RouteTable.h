@@ -15,6 +15,11 @@
 
 namespace Radicle { namespace SDRP
 {
+	/**
+	 *	Table of routes to servers. Routes are grouped by next hop, and the services of each
+	 *	group are aggregated into an attenuated bloom filter indexed by hop count, such that
+	 *	lookups probe one filter per neighbour rather than one per route.
+	 */
 	class RouteTable
 	{
 	public:
@@ -50,6 +55,26 @@ namespace Radicle { namespace SDRP
 		 * @return		All Available Routes to Service
 		 */
 		std::set<Route> RoutesToService( const RDServiceIdentifier service ) const;
+
+		/**
+		 *	Find the neighbour which reaches the specified service in the fewest hops, judged by
+		 *	the services aggregated for each neighbour alone
+		 * @param service		Service
+		 * @param nextHop[out]		Neighbour reaching the service in the fewest hops
+		 * @param hops[out]		Hops to the service through that neighbour. Hop counts beyond
+		 *				the aggregate's depth read as its last level.
+		 * @return			True - If any neighbour may reach the service. False otherwise.
+		 */
+		bool NearestNextHop( 	const RDServiceIdentifier service,
+					RDNetworkAddress& nextHop,
+					RDSize& hops ) const;
+
+		/**
+		 *	Get the services aggregated for routes through the specified neighbour
+		 * @param nextHop	Neighbour Address
+		 * @return		Aggregated Services, empty if no route passes through the neighbour
+		 */
+		const AttenuatedBloomFilter& ServicesThrough( const RDNetworkAddress nextHop ) const;
 	
 		/**
 		 *	Check whether a route to the specified host is available
@@ -76,11 +101,19 @@ namespace Radicle { namespace SDRP
 	
 	private:
 	
-		/// Convenience Typedef
-		typedef std::list<Route>	RouteList;
+		/// Convenience Typedefs
+		typedef std::list<Route>					RouteList;
+		typedef std::pair<AttenuatedBloomFilter, RouteList>		NextHopRoutes;
+		typedef std::map<RDNetworkAddress, NextHopRoutes>		NextHopMap;
+
+		/**
+		 *	Rebuild the aggregated services of a next hop from its routes
+		 * @param routes	Routes through the next hop
+		 */
+		void Aggregate( NextHopRoutes& routes );
 	
-		/// Routes
-		RouteList	m_routes;
+		/// Routes and their Aggregated Services by Next Hop
+		NextHopMap	m_nextHops;
 	};
 } }
 
@@ -21,6 +21,10 @@ namespace Radicle { namespace SDRP
 
 	const RDTimeStamp	RoutingManager::DefaultMaxRelay 		= 10;
 
+	const RDSize		RoutingManager::SizingHeadroom 			= 2;
+
+	const RDUInt16		RoutingManager::KeyframeInterval 		= 10;
+
 	RoutingManager::RoutingManager( SDRPDelegate& delegate, Node& localNode, RDUInt8 ttl ) :
 	m_delegate( delegate ),
 	m_node( localNode ),
@@ -28,7 +32,13 @@ namespace Radicle { namespace SDRP
 	m_ttl( ttl ),
 	m_lastRelay( 0 ),
 	m_monitor( localNode ),
-	m_maxRelay( DefaultMaxRelay )
+	m_maxRelay( DefaultMaxRelay ),
+	m_automaticSizing( false ),
+	m_sizedFor( 0 ),
+	m_deltaBeacons( false ),
+	m_keyframe( ( RDSize ) 0, ( RDSize ) 0 ),
+	m_deltaSequence( 0 ),
+	m_handling( 0 )
 	{
 		m_monitor.Subscribe( this );
 	}
@@ -42,7 +52,59 @@ namespace Radicle { namespace SDRP
 	
 	void RoutingManager::ExpectedNeighbourCount( const RDSize count )
 	{
-		m_node.Neighbours( m_monitor.NeighbourFilter( true, count ) );
+		m_automaticSizing = false;
+		SizeNeighbourFilter( count );
+	}
+
+	void RoutingManager::AutomaticSizing( const bool enabled )
+	{
+		m_automaticSizing = enabled;
+		m_sizedFor = 0;
+	}
+
+	void RoutingManager::DeltaBeacons( const bool enabled )
+	{
+		// Deltas only follow a full beacon sent while enabled
+		m_deltaBeacons = enabled;
+		m_keyframe.DestructiveResize( 0, 0 );
+		m_deltaSequence = 0;
+	}
+
+	void RoutingManager::ResizeFilters()
+	{
+		if( m_automaticSizing == false )
+		{
+			return;
+		}
+
+		RDSize expected = m_monitor.ExpectedNeighbourCount();
+		expected = expected > 0 ? expected : 1;
+
+		if( m_sizedFor == 0 || expected > m_sizedFor || expected * SizingHeadroom * SizingHeadroom <= m_sizedFor )
+		{
+			m_sizedFor = expected * SizingHeadroom;
+			SizeNeighbourFilter( m_sizedFor );
+
+			RD_NLOG( "Resized Neighbour Filter for " << m_sizedFor << " Neighbours" );
+		}
+	}
+	
+	void RoutingManager::SizeNeighbourFilter( const RDSize count )
+	{
+		const LocalAreaMonitor::NodeContainer& neighbours = m_monitor.Neighbours();
+
+		// Lost neighbours are removed from the filter, so it must stay a counting filter whatever
+		// layout membership filters use
+		BloomFilter filter( 	count > neighbours.size() ? count : neighbours.size(),
+					BloomFilter::DesiredFalsePositiveRate,
+					BloomFilter::Counting );
+
+		for( LocalAreaMonitor::NodeContainer::const_iterator i = neighbours.begin(); i != neighbours.end(); ++i )
+		{
+			filter.Insert( i->Address() );
+		}
+
+		m_node.Neighbours( filter );
 	}
 	
 	void RoutingManager::Mode( MPRFactory::MPRSelectionMode mode )
@@ -61,12 +123,14 @@ namespace Radicle { namespace SDRP
 	{
 		RDUByte8 type;
 		RDSize offset = 0;
+
+		m_handling++;
 		
 		if( Serializer::Deserialize( packet, packetSize, offset, offset, type ) )
 		{
 			if( type == Beacon::Type )
 			{
-				Beacon beacon;
+				Beacon beacon( m_scratch );
 				
 				RD_NLOG( "Received Beacon from Node " << source );
 				
@@ -79,13 +143,26 @@ namespace Radicle { namespace SDRP
 					RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Beacon Deserializate Failed" );
 				}
 			}
+			else if( type == BeaconDelta::Type )
+			{
+				BeaconDelta delta;
+
+				if( delta.Deserialize( packet, packetSize, 0, offset ) )
+				{
+					HandleBeaconDelta( source, delta );
+				}
+				else
+				{
+					RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Beacon Delta Deserialization Failed" );
+				}
+			}
 			else if( type == ServiceAdvertisement::Type )
 			{
 				ServiceAdvertisement advertisement;
 								
-				if( advertisement.Deserialize( packet, packetSize, 0, offset ) )
+				if( advertisement.Inspect( packet, packetSize, 0, offset ) )
 				{ 
-					HandleAdvertisement( source, advertisement );
+					HandleAdvertisement( source, advertisement, packet, packetSize );
 				}
 				else
 				{
@@ -101,6 +178,12 @@ namespace Radicle { namespace SDRP
 		{
 			RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Failed to Deserialize Packet" );
 		}
+
+		// Anything kept from the packet was copied out of the arena
+		if( --m_handling == 0 )
+		{
+			m_scratch.Reset();
+		}
 	}
 
 	void RoutingManager::SendBeacon()
@@ -108,6 +191,8 @@ namespace Radicle { namespace SDRP
 		if( m_monitor.Mode() == MPRFactory::MPR )
 		{
 			RDUByte8 buffer[PacketSize];
+
+			ResizeFilters();
 		
 			RD_ASSERT(	m_node.Neighbours().TableSize() > 0,
 					RD_SDRP_ERROR_FILTER_SIZE,
@@ -118,6 +203,23 @@ namespace Radicle { namespace SDRP
 		
 			if( beacon.Serialize( buffer, PacketSize, 0, offset ) )
 			{
+				std::vector<RDSize> slots;
+				RDUByte8 deltaBuffer[PacketSize];
+				RDSize deltaOffset;
+
+				// A delta is only sent if it is smaller than the full beacon
+				if( 	m_deltaBeacons && m_deltaSequence < KeyframeInterval &&
+					m_keyframe.DifferingSlots( m_node.Neighbours(), slots ) &&
+					BeaconDelta( m_node.Address(), static_cast<RDUInt16>( m_deltaSequence + 1 ), m_keyframe.Digest(), slots ).Serialize( deltaBuffer, PacketSize, 0, deltaOffset ) &&
+					deltaOffset < offset )
+				{
+					m_deltaSequence++;
+					m_delegate.Send( deltaBuffer, deltaOffset, RD_SDRP_BROADCAST_ADDRESS );
+					return;
+				}
+
+				m_keyframe = m_node.Neighbours();
+				m_deltaSequence = 0;
 				m_delegate.Send( buffer, offset, RD_SDRP_BROADCAST_ADDRESS );
 			}
 			else
@@ -189,16 +291,37 @@ namespace Radicle { namespace SDRP
 				RD_SDRP_ERROR_FILTER_SIZE,
 				"Neighbours Filter Deserialized with Size 0" );
 		
-		m_monitor.NodeWasSeen( neighbour );
+		m_monitor.KeyframeWasSeen( neighbour );
+	}
+
+	void RoutingManager::HandleBeaconDelta(	const RDNetworkAddress source, 
+						const BeaconDelta& delta )
+	{
+		if( m_monitor.DeltaWasSeen( source, delta.Base(), delta.Sequence(), delta.Slots(), m_delegate.Time() ) == false )
+		{
+			RD_NLOG( "Beacon Delta from Node " << source << " does not apply to its last Full Beacon" );
+		}
 	}
 	
 	void RoutingManager::HandleAdvertisement(	const RDNetworkAddress source, 
-							ServiceAdvertisement& advertisement )
+							ServiceAdvertisement& advertisement,
+							const RDUByte8* packet,
+							const RDSize packetSize )
 	{
 		if( m_monitor.Mode() == MPRFactory::ReducedMPR )
 		{
-			Node neighbour( source, BloomFilter(), advertisement.Neighbours(), m_delegate.Time() );
-			m_monitor.NodeWasSeen( neighbour );
+			BloomFilter neighbours;
+			neighbours.Allocator( m_scratch );
+
+			if( advertisement.NeighboursView().Materialize( neighbours ) )
+			{
+				Node neighbour( source, BloomFilter(), neighbours, m_delegate.Time() );
+				m_monitor.NodeWasSeen( neighbour );
+			}
+			else
+			{
+				RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Advertisement Neighbours Deserialization Failed" );
+			}
 		}
 
 		if( advertisement.Source() == m_node.Address() )
@@ -207,9 +330,18 @@ namespace Radicle { namespace SDRP
 			return;
 		}
 	
+		BloomFilter services;
+		services.Allocator( m_scratch );
+
+		if( advertisement.ServicesView().Materialize( services ) == false )
+		{
+			RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Advertisement Services Deserialization Failed" );
+			return;
+		}
+
 		Route 	newRoute( 	advertisement.Source(),
 					source,
-					advertisement.Services(),
+					services,
 					advertisement.Hops() );
 	
 		m_routes.Add( newRoute );
@@ -233,12 +365,22 @@ namespace Radicle { namespace SDRP
 			return;
 		}
 		// If we're in the destinations filter or not in the neighbour filter, relay the advertisement
-		if( 	advertisement.Destinations().Contains( m_node.Address() ) ||
+		if( 	advertisement.DestinationsView().Contains( m_node.Address() ) ||
 			( 	m_monitor.Mode() == MPRFactory::ReducedMPR && 
-				advertisement.Neighbours().Contains( m_node.Address() ) == false ) ) 
+				advertisement.NeighboursView().Contains( m_node.Address() ) == false ) ) 
 		{	
-			advertisement.HopsIncrement();
-			SendAdvertisement( advertisement );
+			// Only relayed advertisements need their filters deserialized
+			RDSize offset;
+
+			if( advertisement.Deserialize( packet, packetSize, 0, offset ) )
+			{
+				advertisement.HopsIncrement();
+				SendAdvertisement( advertisement );
+			}
+			else
+			{
+				RD_ERROR( RD_SDRP_ERROR_DESERIALIZATION_FAILURE, "Relayed Advertisement Deserialization Failed" );
+			}
 		}
 	}
 	
@@ -10,12 +10,14 @@
 #ifndef RD_SDRP_ROUTING_MANAGER_H
 #define RD_SDRP_ROUTING_MANAGER_H
 
+#include <map>
 #include <SDRP/SDRPDelegate.h>
 #include <SDRP/Core/Core.h>
 #include <SDRP/Routing/Node.h>
 #include <SDRP/Routing/LocalAreaMonitor.h>
 #include <SDRP/Routing/RouteTable.h>
 #include <SDRP/Packets/Beacon.h>
+#include <SDRP/Packets/BeaconDelta.h>
 #include <SDRP/Packets/ServiceAdvertisement.h>
 
 namespace Radicle { namespace SDRP
@@ -39,6 +41,12 @@ namespace Radicle { namespace SDRP
 		static const RDUInt32 		SequenceNumberDriftTolerance;
 		/// Default Max Relay Time
 		static const RDTimeStamp	DefaultMaxRelay;
+
+		/// Factor by which filters are sized beyond the expected neighbour count. Filters are
+		/// resized once the count outgrows them, or shrinks by the square of this factor.
+		static const RDSize		SizingHeadroom;
+		/// Most beacon deltas sent between full beacons when delta beacons are enabled
+		static const RDUInt16		KeyframeInterval;
 	
 		/**
 		 *	Default Constructor
@@ -75,10 +83,27 @@ namespace Radicle { namespace SDRP
 		
 		/**
 		 *	Set the expected neighbour count. This will modify the size of the beacon packet
-		 *	bloom filter used
+		 *	bloom filter used, and disables automatic sizing.
 		 * @param count		Expected number of neighbours
 		 */
 		void ExpectedNeighbourCount( const RDSize count );
+
+		/**
+		 *	Enable or disable automatic sizing. When enabled, the beacon neighbour filter is resized
+		 *	before each beacon to suit the neighbour count expected from the neighbour filters
+		 *	observed in the local area. Off by default, as nodes predating resizable neighbour filters
+		 *	reject beacons whose filter differs in size from their own.
+		 * @param enabled	Whether filters should be sized automatically
+		 */
+		void AutomaticSizing( const bool enabled );
+
+		/**
+		 *	Enable or disable delta beacons. When enabled, a beacon lists only the neighbour filter
+		 *	slots changed since the last full beacon, unless the full beacon would be smaller. A full
+		 *	beacon is sent at least every KeyframeInterval beacons, and whenever the filter is resized.
+		 * @param enabled	Whether beacon deltas should be sent
+		 */
+		void DeltaBeacons( const bool enabled );
 		
 		/**
 		 *	Set the advertisement mode for the routing manager
@@ -151,17 +176,39 @@ namespace Radicle { namespace SDRP
 		 */
 		BloomFilter CalculateMPRFilter() const;
 		
+		/**
+		 *	Resize the beacon neighbour filter if the expected neighbour count has outgrown it
+		 *	or fallen well below it
+		 */
+		void ResizeFilters();
+
+		/**
+		 *	Replace the beacon neighbour filter with a counting filter sized for the given number
+		 *	of neighbours, or the number currently known if greater, holding the current neighbours
+		 * @param count		Expected number of neighbours
+		 */
+		void SizeNeighbourFilter( const RDSize count );
+
 		/**
 		 *	Handle a Beacon Packet
 		 */
 		void HandleBeacon(	const RDNetworkAddress source, 
 					const Beacon& beacon );
+
+		/**
+		 *	Handle a Beacon Delta Packet
+		 */
+		void HandleBeaconDelta(	const RDNetworkAddress source, 
+					const BeaconDelta& delta );
 		
 		/**
-		 *	Handle a Service Advertisement Packet
+		 *	Handle a Service Advertisement Packet. The advertisement has only been inspected and its
+		 *	filters are deserialized from the packet if it is relayed.
 		 */
 		void HandleAdvertisement(	const RDNetworkAddress source, 
-						ServiceAdvertisement& advertisement );
+						ServiceAdvertisement& advertisement,
+						const RDUByte8* packet,
+						const RDSize packetSize );
 
 		/**
 		 *	Send an advertisement
@@ -188,6 +235,20 @@ namespace Radicle { namespace SDRP
 		RDTimeStamp				m_maxRelay;
 		/// Local Area Monitor / MPR Calculator
 		LocalAreaMonitor			m_monitor;
+		/// Indicates whether filters are sized automatically
+		bool					m_automaticSizing;
+		/// Neighbour Count the Beacon Neighbour Filter is sized for. Zero until first sized.
+		RDSize					m_sizedFor;
+		/// Indicates whether beacon deltas are sent
+		bool					m_deltaBeacons;
+		/// Neighbour Filter sent in the last Full Beacon
+		BloomFilter				m_keyframe;
+		/// Beacon Deltas sent since the last Full Beacon
+		RDUInt16				m_deltaSequence;
+		/// Scratch Arena holding the filters of the packet being handled
+		ScratchArena				m_scratch;
+		/// Number of packets being handled, above one when a packet is handled from within another
+		RDSize					m_handling;
 	};
 } }
 
@@ -0,0 +1,510 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Utilities/FilterCodec.h>
+#include <SDRP/Utilities/Serializer.h>
+#include <cstring>
+
+namespace Radicle { namespace SDRP
+{
+	namespace
+	{
+		/// Number of bits holding the Rice parameter of a Golomb coded table
+		const RDSize RiceParameterBits = 5;
+		/// Longest Elias gamma prefix accepted when decoding
+		const RDSize MaximumGammaPrefix = 63;
+
+		/**
+		 *	Writes a most-significant-bit first bit stream. With no output buffer, only counts
+		 *	the bits which would have been written.
+		 */
+		class BitWriter
+		{
+		public:
+
+			BitWriter( RDUByte8* buffer, const RDSize capacity ) :
+			m_buffer( buffer ),
+			m_capacity( capacity ),
+			m_bits( 0 ),
+			m_overflow( false )
+			{}
+
+			/**
+			 *	Write the low \a count bits of \a value, most significant first
+			 */
+			void Write( const RDSize value, const RDSize count )
+			{
+				for( RDSize i = count; i > 0; i-- )
+				{
+					WriteBit( ( value >> ( i - 1 ) ) & 0x01 );
+				}
+			}
+
+			/**
+			 *	Write a single bit
+			 */
+			void WriteBit( const RDSize bit )
+			{
+				if( m_bits / 8 >= m_capacity )
+				{
+					m_overflow = true;
+					return;
+				}
+
+				if( m_buffer != NULL )
+				{
+					if( m_bits % 8 == 0 )
+					{
+						m_buffer[ m_bits / 8 ] = 0x00;
+					}
+
+					m_buffer[ m_bits / 8 ] |= static_cast<RDUByte8>( bit << ( 7 - m_bits % 8 ) );
+				}
+
+				m_bits++;
+			}
+
+			/**
+			 *	Write \a count one bits followed by a zero bit
+			 */
+			void WriteUnary( const RDSize count )
+			{
+				for( RDSize i = 0; i < count && m_overflow == false; i++ )
+				{
+					WriteBit( 1 );
+				}
+
+				WriteBit( 0 );
+			}
+
+			/**
+			 *	Write an Elias gamma code for a value of at least one
+			 */
+			void WriteGamma( const RDSize value )
+			{
+				RDSize width = 0;
+
+				while( ( value >> width ) > 1 )
+				{
+					width++;
+				}
+
+				Write( 0, width );
+				Write( value, width + 1 );
+			}
+
+			/**
+			 *	Get the number of whole bytes written
+			 */
+			RDSize Bytes() const
+			{
+				return ( m_bits + 7 ) / 8;
+			}
+
+			/**
+			 *	Check whether the writer ran out of room
+			 */
+			bool Overflow() const
+			{
+				return m_overflow;
+			}
+
+		private:
+
+			RDUByte8*	m_buffer;
+			RDSize		m_capacity;
+			RDSize		m_bits;
+			bool		m_overflow;
+		};
+
+		/**
+		 *	Reads a most-significant-bit first bit stream, failing rather than reading past its end
+		 */
+		class BitReader
+		{
+		public:
+
+			BitReader( const RDUByte8* buffer, const RDSize size ) :
+			m_buffer( buffer ),
+			m_size( size ),
+			m_bits( 0 ),
+			m_failed( false )
+			{}
+
+			/**
+			 *	Read \a count bits, most significant first
+			 */
+			RDSize Read( const RDSize count )
+			{
+				RDSize value = 0;
+
+				for( RDSize i = 0; i < count; i++ )
+				{
+					value = ( value << 1 ) | ReadBit();
+				}
+
+				return value;
+			}
+
+			/**
+			 *	Read a single bit
+			 */
+			RDSize ReadBit()
+			{
+				if( m_bits / 8 >= m_size )
+				{
+					m_failed = true;
+					return 0;
+				}
+
+				RDSize bit = ( m_buffer[ m_bits / 8 ] >> ( 7 - m_bits % 8 ) ) & 0x01;
+				m_bits++;
+				return bit;
+			}
+
+			/**
+			 *	Read one bits up to a terminating zero bit, giving up beyond \a limit
+			 */
+			RDSize ReadUnary( const RDSize limit )
+			{
+				RDSize count = 0;
+
+				while( m_failed == false && ReadBit() == 1 )
+				{
+					if( ++count > limit )
+					{
+						m_failed = true;
+					}
+				}
+
+				return count;
+			}
+
+			/**
+			 *	Read an Elias gamma code
+			 */
+			RDSize ReadGamma()
+			{
+				RDSize width = 0;
+
+				while( m_failed == false && ReadBit() == 0 )
+				{
+					if( ++width > MaximumGammaPrefix )
+					{
+						m_failed = true;
+					}
+				}
+
+				return m_failed ? 0 : ( static_cast<RDSize>( 1 ) << width ) | Read( width );
+			}
+
+			/**
+			 *	Get the number of whole bytes read
+			 */
+			RDSize Bytes() const
+			{
+				return ( m_bits + 7 ) / 8;
+			}
+
+			/**
+			 *	Check whether the reader ran out of input
+			 */
+			bool Failed() const
+			{
+				return m_failed;
+			}
+
+		private:
+
+			const RDUByte8*	m_buffer;
+			RDSize		m_size;
+			RDSize		m_bits;
+			bool		m_failed;
+		};
+
+		/**
+		 *	Check whether the specified bit of a packed table is set
+		 */
+		inline bool Bit( const RDUByte8* bits, const RDSize bit )
+		{
+			return ( bits[ bit / 8 ] >> ( bit % 8 ) ) & 0x01;
+		}
+
+		/**
+		 *	Get the number of set bits in a packed table
+		 */
+		RDSize Population( const RDUByte8* bits, const RDSize bytes )
+		{
+			RDSize count = 0;
+
+			for( RDSize i = 0; i < bytes; i++ )
+			{
+				for( RDUByte8 byte = bits[ i ]; byte != 0; byte &= byte - 1 )
+				{
+					count++;
+				}
+			}
+
+			return count;
+		}
+
+		/**
+		 *	Write a table as alternating runs
+		 */
+		void WriteRunLength( BitWriter& writer, const RDUByte8* bits, const RDSize bytes )
+		{
+			RDSize length = bytes * 8;
+			bool value = Bit( bits, 0 );
+			RDSize run = 0;
+
+			writer.WriteBit( value ? 1 : 0 );
+
+			for( RDSize bit = 0; bit < length && writer.Overflow() == false; )
+			{
+				// Whole bytes which continue the current run are skipped at once
+				if( bit % 8 == 0 && bits[ bit / 8 ] == ( value ? 0xFF : 0x00 ) )
+				{
+					run += 8;
+					bit += 8;
+					continue;
+				}
+
+				if( Bit( bits, bit ) == value )
+				{
+					run++;
+				}
+				else
+				{
+					writer.WriteGamma( run );
+					value = !value;
+					run = 1;
+				}
+
+				bit++;
+			}
+
+			writer.WriteGamma( run );
+		}
+
+		/**
+		 *	Write a table as Rice coded gaps between set bits
+		 */
+		void WriteGolomb( BitWriter& writer, const RDUByte8* bits, const RDSize bytes )
+		{
+			RDSize length = bytes * 8;
+			RDSize count = Population( bits, bytes );
+
+			writer.WriteGamma( count + 1 );
+
+			if( count == 0 )
+			{
+				return;
+			}
+
+			// The Rice parameter is the largest power of two not exceeding the mean gap
+			RDSize mean = ( length - count ) / count, parameter = 0;
+
+			while( parameter < 31 && ( static_cast<RDSize>( 2 ) << parameter ) <= mean )
+			{
+				parameter++;
+			}
+
+			writer.Write( parameter, RiceParameterBits );
+
+			RDSize next = 0;
+
+			for( RDSize bit = 0; bit < length && writer.Overflow() == false; bit++ )
+			{
+				if( bit % 8 == 0 && bits[ bit / 8 ] == 0x00 )
+				{
+					bit += 7;
+					continue;
+				}
+
+				if( Bit( bits, bit ) )
+				{
+					RDSize gap = bit - next;
+					writer.WriteUnary( gap >> parameter );
+					writer.Write( gap, parameter );
+					next = bit + 1;
+				}
+			}
+		}
+
+		/**
+		 *	Write a table in a compressed encoding
+		 */
+		void Write( BitWriter& writer, const RDUByte8* bits, const RDSize bytes, const FilterCodec::Encoding encoding )
+		{
+			if( encoding == FilterCodec::RunLength )
+			{
+				WriteRunLength( writer, bits, bytes );
+			}
+			else
+			{
+				WriteGolomb( writer, bits, bytes );
+			}
+		}
+
+		/**
+		 *	Read a table written as alternating runs
+		 */
+		bool ReadRunLength( BitReader& reader, RDUByte8* bits, const RDSize bytes )
+		{
+			RDSize length = bytes * 8, filled = 0;
+			bool value = reader.ReadBit() == 1;
+
+			while( filled < length && reader.Failed() == false )
+			{
+				RDSize run = reader.ReadGamma();
+
+				if( reader.Failed() || run > length - filled )
+				{
+					return false;
+				}
+
+				for( ; value && run > 0; run--, filled++ )
+				{
+					bits[ filled / 8 ] |= static_cast<RDUByte8>( 0x01 << ( filled % 8 ) );
+				}
+
+				filled += run;
+				value = !value;
+			}
+
+			return reader.Failed() == false;
+		}
+
+		/**
+		 *	Read a table written as Rice coded gaps between set bits
+		 */
+		bool ReadGolomb( BitReader& reader, RDUByte8* bits, const RDSize bytes )
+		{
+			RDSize length = bytes * 8;
+			RDSize count = reader.ReadGamma() - 1;
+
+			if( reader.Failed() || count > length )
+			{
+				return false;
+			}
+
+			if( count == 0 )
+			{
+				return true;
+			}
+
+			RDSize parameter = reader.Read( RiceParameterBits ), next = 0;
+
+			for( RDSize i = 0; i < count; i++ )
+			{
+				RDSize gap = ( reader.ReadUnary( length ) << parameter ) | reader.Read( parameter );
+
+				if( reader.Failed() || gap >= length - next )
+				{
+					return false;
+				}
+
+				next += gap;
+				bits[ next / 8 ] |= static_cast<RDUByte8>( 0x01 << ( next % 8 ) );
+				next++;
+			}
+
+			return true;
+		}
+	}
+
+	FilterCodec::Encoding FilterCodec::Select( const RDUByte8* bits, const RDSize bytes )
+	{
+		RDSize runLength = EncodedSize( bits, bytes, RunLength );
+		RDSize golomb = EncodedSize( bits, bytes, Golomb );
+
+		if( golomb < bytes && golomb <= runLength )
+		{
+			return Golomb;
+		}
+
+		return runLength < bytes ? RunLength : Raw;
+	}
+
+	RDSize FilterCodec::EncodedSize( const RDUByte8* bits, const RDSize bytes, const Encoding encoding )
+	{
+		if( encoding == Raw || bytes == 0 )
+		{
+			return bytes;
+		}
+
+		// Counting stops once the encoding is no smaller than the raw table
+		BitWriter writer( NULL, bytes );
+		Write( writer, bits, bytes, encoding );
+
+		return writer.Overflow() ? bytes + 1 : writer.Bytes();
+	}
+
+	bool FilterCodec::Encode( 	RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset,
+					const RDUByte8* bits,
+					const RDSize bytes,
+					const Encoding encoding )
+	{
+		if( encoding == Raw || bytes == 0 )
+		{
+			return Serializer::BufferPack( buffer, bufferSize, offset, newOffset, bits, bytes );
+		}
+
+		if( offset > bufferSize )
+		{
+			return false;
+		}
+
+		BitWriter writer( buffer + offset, bufferSize - offset );
+		Write( writer, bits, bytes, encoding );
+
+		if( writer.Overflow() )
+		{
+			return false;
+		}
+
+		newOffset = offset + writer.Bytes();
+		return true;
+	}
+
+	bool FilterCodec::Decode( 	const RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset,
+					RDUByte8* bits,
+					const RDSize bytes,
+					const Encoding encoding )
+	{
+		if( encoding == Raw || bytes == 0 )
+		{
+			return Serializer::BufferUnpack( buffer, bufferSize, offset, newOffset, bits, bytes );
+		}
+
+		if( offset > bufferSize )
+		{
+			return false;
+		}
+
+		BitReader reader( buffer + offset, bufferSize - offset );
+		std::memset( bits, 0, static_cast<size_t>( bytes ) );
+
+		bool success = encoding == RunLength ? ReadRunLength( reader, bits, bytes ) : ReadGolomb( reader, bits, bytes );
+
+		if( success )
+		{
+			newOffset = offset + reader.Bytes();
+		}
+
+		return success;
+	}
+} }
@@ -0,0 +1,99 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_FILTER_CODEC_H
+#define RD_SDRP_FILTER_CODEC_H
+
+#include <SDRP/Core/Types.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	Encodings for packed filter bit tables on the wire. Compressed encodings are written as a
+	 *	most-significant-bit first bit stream padded out to a whole byte, and carry no length of
+	 *	their own: the decoder stops once the table size it was given has been filled.
+	 */
+	class FilterCodec
+	{
+	public:
+
+		/// Table Encodings
+		enum Encoding
+		{
+			/// The packed table, byte for byte
+			Raw,
+			/// Alternating runs of clear and set bits. The first bit of the stream gives the
+			/// value of the first run, and each run length follows as an Elias gamma code.
+			RunLength,
+			/// Positions of the set bits. The number of set bits follows as an Elias gamma code,
+			/// then a 5-bit Rice parameter, then each gap between set bits as a Rice code.
+			Golomb
+		};
+
+		/**
+		 *	Select the encoding which represents the given table in the fewest bytes. Raw is
+		 *	preferred when no compressed encoding is smaller.
+		 * @param bits		Packed Table
+		 * @param bytes		Table Size in Bytes
+		 * @return		Encoding
+		 */
+		static Encoding Select( const RDUByte8* bits, const RDSize bytes );
+
+		/**
+		 *	Get the size of a table under the specified encoding
+		 * @param bits		Packed Table
+		 * @param bytes		Table Size in Bytes
+		 * @param encoding	Encoding
+		 * @return		Encoded Size in Bytes
+		 */
+		static RDSize EncodedSize( const RDUByte8* bits, const RDSize bytes, const Encoding encoding );
+
+		/**
+		 *	Encode a table into the given buffer
+		 * @param buffer	Data buffer into which the table should be encoded
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which encoding should begin
+		 * @param newOffset	New offset produced by encoding the table
+		 * @param bits		Packed Table
+		 * @param bytes		Table Size in Bytes
+		 * @param encoding	Encoding
+		 * @return		True - If the encoded table fit in the buffer. False otherwise.
+		 */
+		static bool Encode( 	RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset,
+					const RDUByte8* bits,
+					const RDSize bytes,
+					const Encoding encoding );
+
+		/**
+		 *	Decode a table from the given buffer
+		 * @param buffer	Data buffer from which the table should be decoded
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which decoding should begin
+		 * @param newOffset	New offset produced by decoding the table
+		 * @param bits		Output Table
+		 * @param bytes		Table Size in Bytes
+		 * @param encoding	Encoding
+		 * @return		True - If a well-formed table of exactly \a bytes bytes was decoded.
+		 *			False otherwise.
+		 */
+		static bool Decode( 	const RDUByte8* buffer,
+					const RDSize bufferSize,
+					const RDSize offset,
+					RDSize& newOffset,
+					RDUByte8* bits,
+					const RDSize bytes,
+					const Encoding encoding );
+	};
+} }
+
+#endif // RD_SDRP_FILTER_CODEC_H
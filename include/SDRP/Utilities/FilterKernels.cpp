@@ -0,0 +1,1067 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#include <SDRP/Utilities/FilterKernels.h>
+#include <cstring>
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define RD_SDRP_KERNELS_X86
+#define RD_SDRP_KERNELS_AVX2
+#define RD_SDRP_TARGET_SSE2	__attribute__(( target( "sse2" ) ))
+#define RD_SDRP_TARGET_AVX2	__attribute__(( target( "avx2" ) ))
+#include <immintrin.h>
+#elif defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define RD_SDRP_KERNELS_X86
+#define RD_SDRP_TARGET_SSE2
+#include <emmintrin.h>
+#include <intrin.h>
+// AVX2 intrinsics, __cpuidex and _xgetbv first shipped with Visual Studio 2012
+#if _MSC_VER >= 1700
+#define RD_SDRP_KERNELS_AVX2
+#define RD_SDRP_TARGET_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+namespace Radicle { namespace SDRP
+{
+	namespace
+	{
+		/**
+		 *	Count the bits set in a 64-bit word
+		 */
+		inline RDSize PopCount( RDSize x )
+		{
+#if defined( __GNUC__ )
+			return __builtin_popcountll( x );
+#else
+			x = x - ( ( x >> 1 ) & 0x5555555555555555ULL );
+			x = ( x & 0x3333333333333333ULL ) + ( ( x >> 2 ) & 0x3333333333333333ULL );
+			x = ( x + ( x >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+			return ( x * 0x0101010101010101ULL ) >> 56;
+#endif
+		}
+
+		/**
+		 *	Load a 64-bit word from an unaligned table position
+		 */
+		inline RDSize Word( const RDUByte8* table, const RDSize offset )
+		{
+			RDSize word;
+			memcpy( &word, table + offset, sizeof( word ) );
+			return word;
+		}
+
+		/// Largest value held by a packed counter. Saturated counters are never decremented.
+		const RDUByte8 CounterMaximum = 0x0F;
+
+		/**
+		 *	Saturating sum of two counters
+		 */
+		inline RDUByte8 CounterSum( const RDUByte8 a, const RDUByte8 b )
+		{
+			return a + b > CounterMaximum ? CounterMaximum : a + b;
+		}
+
+		/**
+		 *	Saturating difference of two counters, leaving saturated counters unchanged
+		 */
+		inline RDUByte8 CounterLess( const RDUByte8 a, const RDUByte8 b )
+		{
+			return a == CounterMaximum ? a : ( a > b ? a - b : 0 );
+		}
+
+		/**
+		 *	Check whether subtracting a counter would empty a non-zero counter
+		 */
+		inline bool CounterEmptied( const RDUByte8 a, const RDUByte8 b )
+		{
+			return a > 0 && a < CounterMaximum && a <= b;
+		}
+
+		//
+		// Scalar Kernels
+		//
+
+		void ScalarCounterUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				result[i] = CounterSum( a[i] & 0x0F, b[i] & 0x0F ) | ( CounterSum( a[i] >> 4, b[i] >> 4 ) << 4 );
+			}
+		}
+
+		void ScalarCounterIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				result[i] = 	( ( a[i] & 0x0F ) != 0 && ( b[i] & 0x0F ) != 0 ? 0x01 : 0x00 ) |
+						( ( a[i] >> 4 ) != 0 && ( b[i] >> 4 ) != 0 ? 0x10 : 0x00 );
+			}
+		}
+
+		void ScalarCounterSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				a[i] = CounterLess( a[i] & 0x0F, b[i] & 0x0F ) | ( CounterLess( a[i] >> 4, b[i] >> 4 ) << 4 );
+			}
+		}
+
+		RDSize ScalarCounterDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize difference = 0;
+
+			for( RDSize i = 0; i < size; i++ )
+			{
+				difference += ( ( a[i] & 0x0F ) != 0 ) != ( ( b[i] & 0x0F ) != 0 ) ? 1 : 0;
+				difference += ( ( a[i] >> 4 ) != 0 ) != ( ( b[i] >> 4 ) != 0 ) ? 1 : 0;
+			}
+
+			return difference;
+		}
+
+		RDSize ScalarCounterPopulation( const RDUByte8* a, const RDSize size )
+		{
+			RDSize population = 0, i = 0;
+
+			// Fold each counter onto its lowest bit and count those
+			for( ; i + sizeof( RDSize ) <= size; i += sizeof( RDSize ) )
+			{
+				RDSize word = Word( a, i );
+				population += PopCount( ( word | ( word >> 1 ) | ( word >> 2 ) | ( word >> 3 ) ) & 0x1111111111111111ULL );
+			}
+
+			for( ; i < size; i++ )
+			{
+				population += ( ( a[i] & 0x0F ) != 0 ? 1 : 0 ) + ( ( a[i] >> 4 ) != 0 ? 1 : 0 );
+			}
+
+			return population;
+		}
+
+		bool ScalarCounterCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				if( 	( ( b[i] & 0x0F ) != 0 && ( a[i] & 0x0F ) == 0 ) ||
+					( ( b[i] >> 4 ) != 0 && ( a[i] >> 4 ) == 0 ) )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool ScalarCounterRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				if( CounterEmptied( a[i] & 0x0F, b[i] & 0x0F ) || CounterEmptied( a[i] >> 4, b[i] >> 4 ) )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void ScalarBitUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				result[i] = a[i] | b[i];
+			}
+		}
+
+		void ScalarBitIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				result[i] = a[i] & b[i];
+			}
+		}
+
+		void ScalarBitSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				a[i] &= ~b[i];
+			}
+		}
+
+		RDSize ScalarBitDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize difference = 0, i = 0;
+
+			for( ; i + sizeof( RDSize ) <= size; i += sizeof( RDSize ) )
+			{
+				difference += PopCount( Word( a, i ) ^ Word( b, i ) );
+			}
+
+			for( ; i < size; i++ )
+			{
+				difference += PopCount( a[i] ^ b[i] );
+			}
+
+			return difference;
+		}
+
+		RDSize ScalarBitPopulation( const RDUByte8* a, const RDSize size )
+		{
+			RDSize population = 0, i = 0;
+
+			for( ; i + sizeof( RDSize ) <= size; i += sizeof( RDSize ) )
+			{
+				population += PopCount( Word( a, i ) );
+			}
+
+			for( ; i < size; i++ )
+			{
+				population += PopCount( a[i] );
+			}
+
+			return population;
+		}
+
+		bool ScalarBitCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				if( ( b[i] & ~a[i] ) != 0 )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool ScalarBitRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				if( ( a[i] & b[i] ) != 0 )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool ScalarAny( const RDUByte8* a, const RDSize size )
+		{
+			for( RDSize i = 0; i < size; i++ )
+			{
+				if( a[i] != 0 )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		const FilterKernels::Table ScalarTable =
+		{
+			ScalarCounterUnion,
+			ScalarCounterIntersection,
+			ScalarCounterSubtract,
+			ScalarCounterDifference,
+			ScalarCounterPopulation,
+			ScalarCounterCovers,
+			ScalarCounterRemovalEmpties,
+			ScalarBitUnion,
+			ScalarBitIntersection,
+			ScalarBitSubtract,
+			ScalarBitDifference,
+			ScalarBitPopulation,
+			ScalarBitCovers,
+			ScalarBitRemovalEmpties,
+			ScalarAny,
+			"Scalar"
+		};
+
+#if defined( RD_SDRP_KERNELS_X86 )
+
+		//
+		// SSE2 Kernels - 16 bytes per iteration, scalar tails
+		//
+
+		RD_SDRP_TARGET_SSE2 inline RDSize SSE2PopCountSum( __m128i x )
+		{
+			return static_cast<RDSize>( _mm_cvtsi128_si32( x ) ) + static_cast<RDSize>( _mm_cvtsi128_si32( _mm_srli_si128( x, 8 ) ) );
+		}
+
+		RD_SDRP_TARGET_SSE2 inline RDSize SSE2PopCount( __m128i x )
+		{
+			const __m128i m1 = _mm_set1_epi8( 0x55 ), m2 = _mm_set1_epi8( 0x33 ), m4 = _mm_set1_epi8( 0x0F );
+
+			x = _mm_sub_epi8( x, _mm_and_si128( _mm_srli_epi16( x, 1 ), m1 ) );
+			x = _mm_add_epi8( _mm_and_si128( x, m2 ), _mm_and_si128( _mm_srli_epi16( x, 2 ), m2 ) );
+			x = _mm_and_si128( _mm_add_epi8( x, _mm_srli_epi16( x, 4 ) ), m4 );
+			x = _mm_sad_epu8( x, _mm_setzero_si128() );
+
+			return SSE2PopCountSum( x );
+		}
+
+		RD_SDRP_TARGET_SSE2 inline void SSE2Unpack( const __m128i x, __m128i& low, __m128i& high )
+		{
+			const __m128i mask = _mm_set1_epi8( 0x0F );
+
+			low = _mm_and_si128( x, mask );
+			high = _mm_and_si128( _mm_srli_epi16( x, 4 ), mask );
+		}
+
+		RD_SDRP_TARGET_SSE2 inline __m128i SSE2Pack( const __m128i low, const __m128i high )
+		{
+			return _mm_or_si128( low, _mm_slli_epi16( high, 4 ) );
+		}
+
+		RD_SDRP_TARGET_SSE2 inline __m128i SSE2Sum( const __m128i a, const __m128i b )
+		{
+			return _mm_min_epu8( _mm_adds_epu8( a, b ), _mm_set1_epi8( CounterMaximum ) );
+		}
+
+		RD_SDRP_TARGET_SSE2 inline __m128i SSE2Both( const __m128i a, const __m128i b )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			return _mm_andnot_si128( _mm_or_si128( _mm_cmpeq_epi8( a, zero ), _mm_cmpeq_epi8( b, zero ) ), _mm_set1_epi8( 1 ) );
+		}
+
+		RD_SDRP_TARGET_SSE2 inline __m128i SSE2Less( const __m128i a, const __m128i b )
+		{
+			__m128i saturated = _mm_cmpeq_epi8( a, _mm_set1_epi8( CounterMaximum ) );
+			return _mm_or_si128( _mm_and_si128( saturated, a ), _mm_andnot_si128( saturated, _mm_subs_epu8( a, b ) ) );
+		}
+
+		RD_SDRP_TARGET_SSE2 inline __m128i SSE2Emptied( const __m128i a, const __m128i b )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			__m128i emptied = _mm_cmpeq_epi8( _mm_subs_epu8( a, b ), zero );
+			__m128i pinned = _mm_or_si128( _mm_cmpeq_epi8( a, zero ), _mm_cmpeq_epi8( a, _mm_set1_epi8( CounterMaximum ) ) );
+			return _mm_andnot_si128( pinned, emptied );
+		}
+
+		RD_SDRP_TARGET_SSE2 void SSE2CounterUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i aLow, aHigh, bLow, bHigh;
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), aLow, aHigh );
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) ), bLow, bHigh );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( result + i ), SSE2Pack( SSE2Sum( aLow, bLow ), SSE2Sum( aHigh, bHigh ) ) );
+			}
+
+			ScalarCounterUnion( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 void SSE2CounterIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i aLow, aHigh, bLow, bHigh;
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), aLow, aHigh );
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) ), bLow, bHigh );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( result + i ), SSE2Pack( SSE2Both( aLow, bLow ), SSE2Both( aHigh, bHigh ) ) );
+			}
+
+			ScalarCounterIntersection( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 void SSE2CounterSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i aLow, aHigh, bLow, bHigh;
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), aLow, aHigh );
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) ), bLow, bHigh );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( a + i ), SSE2Pack( SSE2Less( aLow, bLow ), SSE2Less( aHigh, bHigh ) ) );
+			}
+
+			ScalarCounterSubtract( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 RDSize SSE2CounterDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			RDSize difference = 0, i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i aLow, aHigh, bLow, bHigh;
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), aLow, aHigh );
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) ), bLow, bHigh );
+				__m128i low = _mm_xor_si128( _mm_cmpeq_epi8( aLow, zero ), _mm_cmpeq_epi8( bLow, zero ) );
+				__m128i high = _mm_xor_si128( _mm_cmpeq_epi8( aHigh, zero ), _mm_cmpeq_epi8( bHigh, zero ) );
+				difference += 	PopCount( static_cast<RDUInt32>( _mm_movemask_epi8( low ) ) ) + 
+						PopCount( static_cast<RDUInt32>( _mm_movemask_epi8( high ) ) );
+			}
+
+			return difference + ScalarCounterDifference( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 RDSize SSE2CounterPopulation( const RDUByte8* a, const RDSize size )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			RDSize population = 0, i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i low, high;
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), low, high );
+				population += 	32 - PopCount( static_cast<RDUInt32>( _mm_movemask_epi8( _mm_cmpeq_epi8( low, zero ) ) ) ) -
+						PopCount( static_cast<RDUInt32>( _mm_movemask_epi8( _mm_cmpeq_epi8( high, zero ) ) ) );
+			}
+
+			return population + ScalarCounterPopulation( a + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 bool SSE2CounterCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i aLow, aHigh, bLow, bHigh;
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), aLow, aHigh );
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) ), bLow, bHigh );
+				__m128i low = _mm_andnot_si128( _mm_cmpeq_epi8( bLow, zero ), _mm_cmpeq_epi8( aLow, zero ) );
+				__m128i high = _mm_andnot_si128( _mm_cmpeq_epi8( bHigh, zero ), _mm_cmpeq_epi8( aHigh, zero ) );
+
+				if( _mm_movemask_epi8( _mm_or_si128( low, high ) ) != 0 )
+				{
+					return false;
+				}
+			}
+
+			return ScalarCounterCovers( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 bool SSE2CounterRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i aLow, aHigh, bLow, bHigh;
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), aLow, aHigh );
+				SSE2Unpack( _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) ), bLow, bHigh );
+
+				if( _mm_movemask_epi8( _mm_or_si128( SSE2Emptied( aLow, bLow ), SSE2Emptied( aHigh, bHigh ) ) ) != 0 )
+				{
+					return true;
+				}
+			}
+
+			return ScalarCounterRemovalEmpties( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 void SSE2BitUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) );
+				__m128i vb = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( result + i ), _mm_or_si128( va, vb ) );
+			}
+
+			ScalarBitUnion( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 void SSE2BitIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) );
+				__m128i vb = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( result + i ), _mm_and_si128( va, vb ) );
+			}
+
+			ScalarBitIntersection( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 void SSE2BitSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) );
+				__m128i vb = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i*>( a + i ), _mm_andnot_si128( vb, va ) );
+			}
+
+			ScalarBitSubtract( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 RDSize SSE2BitDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize difference = 0, i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) );
+				__m128i vb = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) );
+				difference += SSE2PopCount( _mm_xor_si128( va, vb ) );
+			}
+
+			return difference + ScalarBitDifference( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 RDSize SSE2BitPopulation( const RDUByte8* a, const RDSize size )
+		{
+			RDSize population = 0, i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				population += SSE2PopCount( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ) );
+			}
+
+			return population + ScalarBitPopulation( a + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 bool SSE2BitCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) );
+				__m128i vb = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) );
+
+				if( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_andnot_si128( va, vb ), zero ) ) != 0xFFFF )
+				{
+					return false;
+				}
+			}
+
+			return ScalarBitCovers( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 bool SSE2BitRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) );
+				__m128i vb = _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) );
+
+				if( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_and_si128( va, vb ), zero ) ) != 0xFFFF )
+				{
+					return true;
+				}
+			}
+
+			return ScalarBitRemovalEmpties( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_SSE2 bool SSE2Any( const RDUByte8* a, const RDSize size )
+		{
+			const __m128i zero = _mm_setzero_si128();
+			RDSize i = 0;
+
+			for( ; i + 16 <= size; i += 16 )
+			{
+				__m128i va = _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) );
+
+				if( _mm_movemask_epi8( _mm_cmpeq_epi8( va, zero ) ) != 0xFFFF )
+				{
+					return true;
+				}
+			}
+
+			return ScalarAny( a + i, size - i );
+		}
+
+		const FilterKernels::Table SSE2Table =
+		{
+			SSE2CounterUnion,
+			SSE2CounterIntersection,
+			SSE2CounterSubtract,
+			SSE2CounterDifference,
+			SSE2CounterPopulation,
+			SSE2CounterCovers,
+			SSE2CounterRemovalEmpties,
+			SSE2BitUnion,
+			SSE2BitIntersection,
+			SSE2BitSubtract,
+			SSE2BitDifference,
+			SSE2BitPopulation,
+			SSE2BitCovers,
+			SSE2BitRemovalEmpties,
+			SSE2Any,
+			"SSE2"
+		};
+
+#if defined( RD_SDRP_KERNELS_AVX2 )
+
+		//
+		// AVX2 Kernels - 32 bytes per iteration, SSE2 tails
+		//
+
+		RD_SDRP_TARGET_AVX2 inline RDSize AVX2PopCount( __m256i x )
+		{
+			const __m256i m1 = _mm256_set1_epi8( 0x55 ), m2 = _mm256_set1_epi8( 0x33 ), m4 = _mm256_set1_epi8( 0x0F );
+
+			x = _mm256_sub_epi8( x, _mm256_and_si256( _mm256_srli_epi16( x, 1 ), m1 ) );
+			x = _mm256_add_epi8( _mm256_and_si256( x, m2 ), _mm256_and_si256( _mm256_srli_epi16( x, 2 ), m2 ) );
+			x = _mm256_and_si256( _mm256_add_epi8( x, _mm256_srli_epi16( x, 4 ) ), m4 );
+			x = _mm256_sad_epu8( x, _mm256_setzero_si256() );
+			x = _mm256_add_epi64( x, _mm256_permute4x64_epi64( x, 0x4E ) );
+
+			return 	SSE2PopCountSum( _mm256_castsi256_si128( x ) );
+		}
+
+		RD_SDRP_TARGET_AVX2 inline void AVX2Unpack( const __m256i x, __m256i& low, __m256i& high )
+		{
+			const __m256i mask = _mm256_set1_epi8( 0x0F );
+
+			low = _mm256_and_si256( x, mask );
+			high = _mm256_and_si256( _mm256_srli_epi16( x, 4 ), mask );
+		}
+
+		RD_SDRP_TARGET_AVX2 inline __m256i AVX2Pack( const __m256i low, const __m256i high )
+		{
+			return _mm256_or_si256( low, _mm256_slli_epi16( high, 4 ) );
+		}
+
+		RD_SDRP_TARGET_AVX2 inline __m256i AVX2Sum( const __m256i a, const __m256i b )
+		{
+			return _mm256_min_epu8( _mm256_adds_epu8( a, b ), _mm256_set1_epi8( CounterMaximum ) );
+		}
+
+		RD_SDRP_TARGET_AVX2 inline __m256i AVX2Both( const __m256i a, const __m256i b )
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			return _mm256_andnot_si256( _mm256_or_si256( _mm256_cmpeq_epi8( a, zero ), _mm256_cmpeq_epi8( b, zero ) ), _mm256_set1_epi8( 1 ) );
+		}
+
+		RD_SDRP_TARGET_AVX2 inline __m256i AVX2Less( const __m256i a, const __m256i b )
+		{
+			__m256i saturated = _mm256_cmpeq_epi8( a, _mm256_set1_epi8( CounterMaximum ) );
+			return _mm256_or_si256( _mm256_and_si256( saturated, a ), _mm256_andnot_si256( saturated, _mm256_subs_epu8( a, b ) ) );
+		}
+
+		RD_SDRP_TARGET_AVX2 inline __m256i AVX2Emptied( const __m256i a, const __m256i b )
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			__m256i emptied = _mm256_cmpeq_epi8( _mm256_subs_epu8( a, b ), zero );
+			__m256i pinned = _mm256_or_si256( _mm256_cmpeq_epi8( a, zero ), _mm256_cmpeq_epi8( a, _mm256_set1_epi8( CounterMaximum ) ) );
+			return _mm256_andnot_si256( pinned, emptied );
+		}
+
+		RD_SDRP_TARGET_AVX2 void AVX2CounterUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i aLow, aHigh, bLow, bHigh;
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ), aLow, aHigh );
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) ), bLow, bHigh );
+				_mm256_storeu_si256( reinterpret_cast<__m256i*>( result + i ), AVX2Pack( AVX2Sum( aLow, bLow ), AVX2Sum( aHigh, bHigh ) ) );
+			}
+
+			SSE2CounterUnion( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 void AVX2CounterIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i aLow, aHigh, bLow, bHigh;
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ), aLow, aHigh );
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) ), bLow, bHigh );
+				_mm256_storeu_si256( reinterpret_cast<__m256i*>( result + i ), AVX2Pack( AVX2Both( aLow, bLow ), AVX2Both( aHigh, bHigh ) ) );
+			}
+
+			SSE2CounterIntersection( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 void AVX2CounterSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i aLow, aHigh, bLow, bHigh;
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ), aLow, aHigh );
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) ), bLow, bHigh );
+				_mm256_storeu_si256( reinterpret_cast<__m256i*>( a + i ), AVX2Pack( AVX2Less( aLow, bLow ), AVX2Less( aHigh, bHigh ) ) );
+			}
+
+			SSE2CounterSubtract( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 RDSize AVX2CounterDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			RDSize difference = 0, i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i aLow, aHigh, bLow, bHigh;
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ), aLow, aHigh );
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) ), bLow, bHigh );
+				__m256i low = _mm256_xor_si256( _mm256_cmpeq_epi8( aLow, zero ), _mm256_cmpeq_epi8( bLow, zero ) );
+				__m256i high = _mm256_xor_si256( _mm256_cmpeq_epi8( aHigh, zero ), _mm256_cmpeq_epi8( bHigh, zero ) );
+				difference += 	PopCount( static_cast<RDUInt32>( _mm256_movemask_epi8( low ) ) ) + 
+						PopCount( static_cast<RDUInt32>( _mm256_movemask_epi8( high ) ) );
+			}
+
+			return difference + SSE2CounterDifference( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 RDSize AVX2CounterPopulation( const RDUByte8* a, const RDSize size )
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			RDSize population = 0, i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i low, high;
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ), low, high );
+				population += 	64 - PopCount( static_cast<RDUInt32>( _mm256_movemask_epi8( _mm256_cmpeq_epi8( low, zero ) ) ) ) -
+						PopCount( static_cast<RDUInt32>( _mm256_movemask_epi8( _mm256_cmpeq_epi8( high, zero ) ) ) );
+			}
+
+			return population + SSE2CounterPopulation( a + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 bool AVX2CounterCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i aLow, aHigh, bLow, bHigh;
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ), aLow, aHigh );
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) ), bLow, bHigh );
+				__m256i low = _mm256_andnot_si256( _mm256_cmpeq_epi8( bLow, zero ), _mm256_cmpeq_epi8( aLow, zero ) );
+				__m256i high = _mm256_andnot_si256( _mm256_cmpeq_epi8( bHigh, zero ), _mm256_cmpeq_epi8( aHigh, zero ) );
+
+				if( _mm256_movemask_epi8( _mm256_or_si256( low, high ) ) != 0 )
+				{
+					return false;
+				}
+			}
+
+			return SSE2CounterCovers( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 bool AVX2CounterRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i aLow, aHigh, bLow, bHigh;
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ), aLow, aHigh );
+				AVX2Unpack( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) ), bLow, bHigh );
+
+				if( _mm256_movemask_epi8( _mm256_or_si256( AVX2Emptied( aLow, bLow ), AVX2Emptied( aHigh, bHigh ) ) ) != 0 )
+				{
+					return true;
+				}
+			}
+
+			return SSE2CounterRemovalEmpties( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 void AVX2BitUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+				__m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) );
+				_mm256_storeu_si256( reinterpret_cast<__m256i*>( result + i ), _mm256_or_si256( va, vb ) );
+			}
+
+			SSE2BitUnion( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 void AVX2BitIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+				__m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) );
+				_mm256_storeu_si256( reinterpret_cast<__m256i*>( result + i ), _mm256_and_si256( va, vb ) );
+			}
+
+			SSE2BitIntersection( result + i, a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 void AVX2BitSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+				__m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) );
+				_mm256_storeu_si256( reinterpret_cast<__m256i*>( a + i ), _mm256_andnot_si256( vb, va ) );
+			}
+
+			SSE2BitSubtract( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 RDSize AVX2BitDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize difference = 0, i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+				__m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) );
+				difference += AVX2PopCount( _mm256_xor_si256( va, vb ) );
+			}
+
+			return difference + SSE2BitDifference( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 RDSize AVX2BitPopulation( const RDUByte8* a, const RDSize size )
+		{
+			RDSize population = 0, i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				population += AVX2PopCount( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) ) );
+			}
+
+			return population + SSE2BitPopulation( a + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 bool AVX2BitCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+				__m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) );
+
+				if( _mm256_testc_si256( va, vb ) == 0 )
+				{
+					return false;
+				}
+			}
+
+			return SSE2BitCovers( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 bool AVX2BitRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+				__m256i vb = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + i ) );
+
+				if( _mm256_testz_si256( va, vb ) == 0 )
+				{
+					return true;
+				}
+			}
+
+			return SSE2BitRemovalEmpties( a + i, b + i, size - i );
+		}
+
+		RD_SDRP_TARGET_AVX2 bool AVX2Any( const RDUByte8* a, const RDSize size )
+		{
+			RDSize i = 0;
+
+			for( ; i + 32 <= size; i += 32 )
+			{
+				__m256i va = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + i ) );
+
+				if( _mm256_testz_si256( va, va ) == 0 )
+				{
+					return true;
+				}
+			}
+
+			return SSE2Any( a + i, size - i );
+		}
+
+		const FilterKernels::Table AVX2Table =
+		{
+			AVX2CounterUnion,
+			AVX2CounterIntersection,
+			AVX2CounterSubtract,
+			AVX2CounterDifference,
+			AVX2CounterPopulation,
+			AVX2CounterCovers,
+			AVX2CounterRemovalEmpties,
+			AVX2BitUnion,
+			AVX2BitIntersection,
+			AVX2BitSubtract,
+			AVX2BitDifference,
+			AVX2BitPopulation,
+			AVX2BitCovers,
+			AVX2BitRemovalEmpties,
+			AVX2Any,
+			"AVX2"
+		};
+#endif
+
+		/**
+		 *	Check whether the running CPU and operating system support SSE2 and AVX2
+		 */
+		void DetectInstructionSets( bool& sse2, bool& avx2 )
+		{
+#if defined( __GNUC__ )
+			__builtin_cpu_init();
+			sse2 = __builtin_cpu_supports( "sse2" ) != 0;
+			avx2 = __builtin_cpu_supports( "avx2" ) != 0;
+#else
+			int info[4];
+			__cpuid( info, 1 );
+			sse2 = ( info[3] & ( 1 << 26 ) ) != 0;
+			avx2 = false;
+#if defined( RD_SDRP_KERNELS_AVX2 )
+			bool osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+			__cpuidex( info, 7, 0 );
+			avx2 = osxsave && ( info[1] & ( 1 << 5 ) ) != 0 && ( _xgetbv( 0 ) & 0x06 ) == 0x06;
+#endif
+#endif
+		}
+#endif
+	}
+
+	const FilterKernels::Table*	FilterKernels::m_active = &ScalarTable;
+	bool				FilterKernels::Selected = FilterKernels::Select();
+
+	bool FilterKernels::Select()
+	{
+#if defined( RD_SDRP_KERNELS_X86 )
+		bool sse2 = false, avx2 = false;
+		DetectInstructionSets( sse2, avx2 );
+
+#if defined( RD_SDRP_KERNELS_AVX2 )
+		if( avx2 )
+		{
+			m_active = &AVX2Table;
+			return true;
+		}
+#endif
+		if( sse2 )
+		{
+			m_active = &SSE2Table;
+		}
+#endif
+		return true;
+	}
+
+	void FilterKernels::CounterUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		m_active->CounterUnion( result, a, b, size );
+	}
+
+	void FilterKernels::CounterIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		m_active->CounterIntersection( result, a, b, size );
+	}
+
+	void FilterKernels::CounterSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		m_active->CounterSubtract( a, b, size );
+	}
+
+	RDSize FilterKernels::CounterDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		return m_active->CounterDifference( a, b, size );
+	}
+
+	RDSize FilterKernels::CounterPopulation( const RDUByte8* a, const RDSize size )
+	{
+		return m_active->CounterPopulation( a, size );
+	}
+
+	bool FilterKernels::CounterCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		return m_active->CounterCovers( a, b, size );
+	}
+
+	bool FilterKernels::CounterRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		return m_active->CounterRemovalEmpties( a, b, size );
+	}
+
+	void FilterKernels::BitUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		m_active->BitUnion( result, a, b, size );
+	}
+
+	void FilterKernels::BitIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		m_active->BitIntersection( result, a, b, size );
+	}
+
+	void FilterKernels::BitSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		m_active->BitSubtract( a, b, size );
+	}
+
+	RDSize FilterKernels::BitDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		return m_active->BitDifference( a, b, size );
+	}
+
+	RDSize FilterKernels::BitPopulation( const RDUByte8* a, const RDSize size )
+	{
+		return m_active->BitPopulation( a, size );
+	}
+
+	bool FilterKernels::BitCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		return m_active->BitCovers( a, b, size );
+	}
+
+	bool FilterKernels::BitRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size )
+	{
+		return m_active->BitRemovalEmpties( a, b, size );
+	}
+
+	bool FilterKernels::Any( const RDUByte8* a, const RDSize size )
+	{
+		return m_active->Any( a, size );
+	}
+
+	const RDChar8* FilterKernels::InstructionSet()
+	{
+		return m_active->Name;
+	}
+} }
@@ -0,0 +1,175 @@
+/************************************************************************
+ * Radicle Design		   					*
+ * Service Discovery Routing Protocol					*
+ *									*
+ * Author: 	Warren Kenny	<warren.kenny@gmail.com>		*
+ * Platforms:	ns-2, Unix, Windows					*
+ * 									*
+ * Copyright 2012 Radicle Design. All rights reserved.			*
+ ************************************************************************/
+
+#ifndef RD_SDRP_FILTER_KERNELS_H
+#define RD_SDRP_FILTER_KERNELS_H
+
+#include <SDRP/Core/Types.h>
+
+namespace Radicle { namespace SDRP
+{
+	/**
+	 *	Word-wise kernels for bloom filter set algebra over raw filter tables. Counter kernels
+	 *	operate on tables packing two 4-bit counters into each byte, the even slot in the low
+	 *	nibble, and treat saturated counters as sticky. Bit kernels operate on tables holding one 
+	 *	slot per bit. The widest instruction set supported by the running CPU is selected at startup.
+	 */
+	class FilterKernels
+	{
+	public:
+
+		/**
+		 *	Add two counter tables, saturating at the counter maximum of 15
+		 * @param result	Output Table
+		 * @param a		First Table
+		 * @param b		Second Table
+		 * @param size		Table Size in Bytes
+		 */
+		static void CounterUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Set each output counter to 1 where both input counters are non-zero, 0 otherwise
+		 * @param result	Output Table
+		 * @param a		First Table
+		 * @param b		Second Table
+		 * @param size		Table Size in Bytes
+		 */
+		static void CounterIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Subtract the counters of \a b from \a a in place, saturating at zero. Saturated counters
+	 *	of \a a are left unchanged.
+		 * @param a		Table to be modified
+		 * @param b		Subtracted Table
+		 * @param size		Table Size in Bytes
+		 */
+		static void CounterSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Count the slots which are set in exactly one of the two counter tables
+		 * @param a		First Table
+		 * @param b		Second Table
+		 * @param size		Table Size in Bytes
+		 * @return		Number of differently set slots
+		 */
+		static RDSize CounterDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Count the non-zero counters in a table
+		 * @param a		Table
+		 * @param size		Table Size in Bytes
+		 * @return		Number of set slots
+		 */
+		static RDSize CounterPopulation( const RDUByte8* a, const RDSize size );
+
+		/**
+		 *	Check whether every slot set in \a b is also set in \a a
+		 * @param a		Covering Table
+		 * @param b		Covered Table
+		 * @param size		Table Size in Bytes
+		 * @return		True - If \a a covers \a b. False otherwise.
+		 */
+		static bool CounterCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Check whether subtracting \a b from \a a would empty any set, unsaturated slot of \a a
+		 * @param a		First Table
+		 * @param b		Second Table
+		 * @param size		Table Size in Bytes
+		 * @return		True - If a set slot would be emptied. False otherwise.
+		 */
+		static bool CounterRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Bitwise OR of two bit tables
+		 */
+		static void BitUnion( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Bitwise AND of two bit tables
+		 */
+		static void BitIntersection( RDUByte8* result, const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Clear the bits of \a a which are set in \a b
+		 */
+		static void BitSubtract( RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Count the bits which differ between two bit tables
+		 */
+		static RDSize BitDifference( const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Count the bits set in a bit table
+		 */
+		static RDSize BitPopulation( const RDUByte8* a, const RDSize size );
+
+		/**
+		 *	Check whether every bit set in \a b is also set in \a a
+		 */
+		static bool BitCovers( const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Check whether any bit is set in both tables
+		 */
+		static bool BitRemovalEmpties( const RDUByte8* a, const RDUByte8* b, const RDSize size );
+
+		/**
+		 *	Check whether any byte of a table is non-zero
+		 * @param a		Table
+		 * @param size		Table Size in Bytes
+		 * @return		True - If any byte is non-zero. False otherwise.
+		 */
+		static bool Any( const RDUByte8* a, const RDSize size );
+
+		/**
+		 *	Get the name of the instruction set used by the kernels
+		 * @return	Instruction Set Name
+		 */
+		static const RDChar8* InstructionSet();
+
+		/// Kernel Dispatch Table
+		struct Table
+		{
+			void 	( *CounterUnion )( RDUByte8*, const RDUByte8*, const RDUByte8*, const RDSize );
+			void 	( *CounterIntersection )( RDUByte8*, const RDUByte8*, const RDUByte8*, const RDSize );
+			void 	( *CounterSubtract )( RDUByte8*, const RDUByte8*, const RDSize );
+			RDSize 	( *CounterDifference )( const RDUByte8*, const RDUByte8*, const RDSize );
+			RDSize 	( *CounterPopulation )( const RDUByte8*, const RDSize );
+			bool 	( *CounterCovers )( const RDUByte8*, const RDUByte8*, const RDSize );
+			bool 	( *CounterRemovalEmpties )( const RDUByte8*, const RDUByte8*, const RDSize );
+			void 	( *BitUnion )( RDUByte8*, const RDUByte8*, const RDUByte8*, const RDSize );
+			void 	( *BitIntersection )( RDUByte8*, const RDUByte8*, const RDUByte8*, const RDSize );
+			void 	( *BitSubtract )( RDUByte8*, const RDUByte8*, const RDSize );
+			RDSize 	( *BitDifference )( const RDUByte8*, const RDUByte8*, const RDSize );
+			RDSize 	( *BitPopulation )( const RDUByte8*, const RDSize );
+			bool 	( *BitCovers )( const RDUByte8*, const RDUByte8*, const RDSize );
+			bool 	( *BitRemovalEmpties )( const RDUByte8*, const RDUByte8*, const RDSize );
+			bool 	( *Any )( const RDUByte8*, const RDSize );
+			const RDChar8* Name;
+		};
+
+	private:
+
+		/// Active Kernel Table. Scalar until the CPU has been inspected at startup.
+		static const Table* m_active;
+		/// Indicates whether the CPU has been inspected. Calculated at runtime.
+		static bool Selected;
+
+		/**
+		 *	Select the widest kernel table supported by the running CPU
+		 * @return	True
+		 */
+		static bool Select();
+	};
+} }
+
+#endif // RD_SDRP_FILTER_KERNELS_H
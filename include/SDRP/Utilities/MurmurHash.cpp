@@ -9,9 +9,47 @@
  ************************************************************************/
  
 #include <SDRP/Utilities/MurmurHash.h>
+#include <cstring>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define RD_SDRP_MURMUR_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace Radicle { namespace SDRP
 {
+	namespace
+	{
+		/// MurmurHash2 Multiplier
+		const RDUInt32 Multiplier = 0x5bd1e995;
+
+		/**
+		 *	Hash a single 16-bit value. Matches MurmurHash::Hash over the value's two bytes.
+		 */
+		inline RDUInt32 HashPair( const RDUByte8* data, const RDUInt32 seed )
+		{
+			RDUInt32 h = ( seed ^ 2 ) ^ ( ( static_cast<RDUInt32>( data[ 0 ] ) << 8 ) | data[ 1 ] );
+			h *= Multiplier;
+			h ^= h >> 13;
+			h *= Multiplier;
+			h ^= h >> 15;
+			return h;
+		}
+
+#ifdef RD_SDRP_MURMUR_SSE2
+		/**
+		 *	Multiply four 32-bit lanes, keeping the low half of each product
+		 */
+		inline __m128i SSE2Multiply( const __m128i a, const __m128i b )
+		{
+			__m128i even = _mm_mul_epu32( a, b );
+			__m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+			return _mm_unpacklo_epi32( 	_mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ), 
+							_mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+		}
+#endif
+	}
+
 	RDUInt32 MurmurHash::Hash( 	const RDUByte8* data, 
 					const RDUInt32 dataSize, 
 					const RDUInt32 seed )
@@ -67,5 +105,84 @@ namespace Radicle { namespace SDRP
 
 		return h;
 	}
+
+	void MurmurHash::HashMany( const RDUInt16* data, RDUInt32* hashes, const RDSize count )
+	{
+		RDSize i = 0;
+
+#ifdef RD_SDRP_MURMUR_SSE2
+		const __m128i multiplier = _mm_set1_epi32( static_cast<int>( Multiplier ) );
+		const __m128i length = _mm_set1_epi32( 2 );
+
+		for( ; i + 4 <= count; i += 4 )
+		{
+			// The tail of MurmurHash2 takes the first byte as the high one, and x86 is little-endian
+			__m128i values = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( data + i ) );
+			values = _mm_or_si128( _mm_slli_epi16( values, 8 ), _mm_srli_epi16( values, 8 ) );
+			values = _mm_unpacklo_epi16( values, _mm_setzero_si128() );
+			__m128i h = _mm_loadu_si128( reinterpret_cast<const __m128i*>( hashes + i ) );
+
+			h = SSE2Multiply( _mm_xor_si128( _mm_xor_si128( h, length ), values ), multiplier );
+			h = _mm_xor_si128( h, _mm_srli_epi32( h, 13 ) );
+			h = SSE2Multiply( h, multiplier );
+			h = _mm_xor_si128( h, _mm_srli_epi32( h, 15 ) );
+
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( hashes + i ), h );
+		}
+#endif
+
+		for( ; i < count; i++ )
+		{
+			RDUByte8 bytes[ sizeof( RDUInt16 ) ];
+			memcpy( bytes, data + i, sizeof( bytes ) );
+			hashes[ i ] = HashPair( bytes, hashes[ i ] );
+		}
+	}
+
+	RDSize MurmurHash::Hash64( 	const RDUByte8* data, 
+					const RDUInt32 dataSize, 
+					const RDSize seed )
+	{
+		RDSize m = 0xc6a4a7935bd1e995ULL;
+		RDUInt32 r = 47;
+
+		RDSize h = seed ^ ( dataSize * m );
+
+		RDUInt32 len_8 = dataSize >> 3;
+
+		for( RDUInt32 i = 0; i < len_8; i++ )
+		{
+			RDSize k = 0;
+
+			for( RDUInt32 b = 8; b > 0; b-- )
+			{
+				k = ( k << 8 ) | data[ ( i << 3 ) + b - 1 ];
+			}
+
+			k *= m;
+			k ^= k >> r;
+			k *= m;
+			h ^= k;
+			h *= m;
+		}
+
+		RDUInt32 left = dataSize & 7;
+
+		if( left != 0 )
+		{
+			for( RDUInt32 b = left; b > 0; b-- )
+			{
+				h ^= static_cast<RDSize>( data[ dataSize - left + b - 1 ] ) << ( ( b - 1 ) * 8 );
+			}
+
+			h *= m;
+		}
+
+		h ^= h >> r;
+		h *= m;
+		h ^= h >> r;
+
+		return h;
+	}
 } }
  
@@ -42,6 +42,37 @@ namespace Radicle { namespace SDRP
 		{
 			return Hash( reinterpret_cast<const RDUByte8*>( &data ), sizeof( T ), seed );
 		}
+
+		/**
+		 *	Generate 32-Bit Hashes for many 16-bit values at once, each seeded separately. Equivalent
+		 *	to hashes[ i ] = Hash( data[ i ], hashes[ i ] ), with several values hashed per step
+		 *	in SIMD lanes where available.
+		 * @param data		Values to be hashed
+		 * @param hashes	Seeds on input, hashes on output
+		 * @param count		Number of values
+		 */
+		static void HashMany( const RDUInt16* data, RDUInt32* hashes, const RDSize count );
+
+		/**
+		 *	Generate a 64-Bit Hash from the provided data, using the seed for randomization
+		 * @param data		Data Buffer 
+		 * @param dataSize	Data Buffer Size in Bytes
+		 * @param seed		Hash Seed
+		 * @return		64-Bit Hash
+		 */
+		static RDSize Hash64( const RDUByte8* data, const RDUInt32 dataSize, const RDSize seed );
+
+		/**
+		 *	Generate a 64-Bit Hash from the provided data, using the seed for randomization
+		 * @param data		Data 
+		 * @param seed		Hash Seed
+		 * @return		64-Bit Hash
+		 */
+		template<typename T>
+		static RDSize Hash64( const T& data, const RDSize seed )
+		{
+			return Hash64( reinterpret_cast<const RDUByte8*>( &data ), sizeof( T ), seed );
+		}
 	};
 } }
 
@@ -90,6 +90,59 @@ namespace Radicle { namespace SDRP
 			EndianSwap( &integer, sizeof( integer ) );
 	}
 	
+	bool Serializer::SerializeVarint( RDUByte8* buffer, const RDSize bufferSize, const RDSize offset, RDSize& newOffset, const RDSize integer )
+	{
+		RDSize remaining = integer, position = offset;
+
+		do
+		{
+			if( position >= bufferSize )
+			{
+				return false;
+			}
+
+			RDUByte8 group = static_cast<RDUByte8>( remaining & 0x7F );
+			remaining >>= 7;
+			buffer[ position++ ] = remaining != 0 ? group | 0x80 : group;
+		}
+		while( remaining != 0 );
+
+		newOffset = position;
+		return true;
+	}
+
+	bool Serializer::DeserializeVarint( const RDUByte8* buffer, const RDSize bufferSize, const RDSize offset, RDSize& newOffset, RDSize& integer )
+	{
+		RDSize value = 0, position = offset;
+
+		for( RDSize shift = 0; shift < 64; shift += 7 )
+		{
+			if( position >= bufferSize )
+			{
+				return false;
+			}
+
+			RDUByte8 group = buffer[ position++ ];
+
+			// The tenth group may only carry the single remaining bit
+			if( shift == 63 && group > 0x01 )
+			{
+				return false;
+			}
+
+			value |= static_cast<RDSize>( group & 0x7F ) << shift;
+
+			if( ( group & 0x80 ) == 0 )
+			{
+				integer = value;
+				newOffset = position;
+				return true;
+			}
+		}
+
+		return false;
+	}
+	
 	bool Serializer::BufferPack(	RDUByte8* buffer,
 					const RDSize bufferSize,
 					const RDSize offset,
@@ -53,6 +53,29 @@ namespace Radicle { namespace SDRP
 		static bool Deserialize( const RDUByte8* buffer, const RDSize bufferSize, const RDSize offset,	RDSize& newOffset, RDUInt32& integer );
 		static bool Deserialize( const RDUByte8* buffer, const RDSize bufferSize, const RDSize offset,	RDSize& newOffset, RDInt32& integer );
 		static bool Deserialize( const RDUByte8* buffer, const RDSize bufferSize, const RDSize offset,	RDSize& newOffset, RDSize& integer );
+
+		/**
+		 *	Serialize the provided integer as an unsigned LEB128 varint, seven bits to a byte with
+		 *	the least significant group first
+		 * @param buffer	Data buffer into which the integer should be serialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which serialization should begin
+		 * @param newOffset	New offset produced by serializing the integer
+		 * @param integer	Integer to be serialized
+		 * @return		True - If serialization was successful. False otherwise.
+		 */
+		static bool SerializeVarint( RDUByte8* buffer, const RDSize bufferSize, const RDSize offset, RDSize& newOffset, const RDSize integer );
+
+		/**
+		 *	Deserialize an unsigned LEB128 varint from the given buffer
+		 * @param buffer	Data buffer from which the integer should be deserialized
+		 * @param bufferSize	Size of the buffer in bytes
+		 * @param offset	Offset into the buffer at which deserialization should begin
+		 * @param newOffset	New offset produced by deserializing the integer
+		 * @param integer	Integer to be deserialized
+		 * @return		True - If a varint of at most 64 bits was deserialized. False otherwise.
+		 */
+		static bool DeserializeVarint( const RDUByte8* buffer, const RDSize bufferSize, const RDSize offset, RDSize& newOffset, RDSize& integer );
 		
 		/**
 		 *	Serialize the provided object into the target buffer